@@ -0,0 +1,93 @@
+#ifndef THZ_IMAGE_COMMON_IIMAGESTREAMWRITER_HPP
+#define THZ_IMAGE_COMMON_IIMAGESTREAMWRITER_HPP
+
+#include "THzCommon/math/rectangle.hpp"
+#include "iImageTransformer.hpp"
+#include "pixel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <gsl/gsl>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Interface for all classes writing images row by row, without the whole image being in memory.
+///
+/// @tparam TPixelType The pixel type of the writer.
+template <Pixel TPixelType>
+class IImageStreamWriter
+{
+public:
+    /// @brief Default the destructor to make it virtual.
+    virtual ~IImageStreamWriter() noexcept {}
+
+    /// @brief Starts writing an image of the given dimensions.
+    ///
+    /// @param dimensions The dimensions of the image.
+    /// @return True if writing was started, false otherwise.
+    virtual bool begin(Rectangle const &dimensions) noexcept = 0;
+
+    /// @brief Writes the next rows of the image, starting with the top row.
+    ///
+    /// @param rows The rows to write, the size has to be a multiple of the width of the image.
+    /// @return True if the rows were written, false otherwise.
+    virtual bool writeRows(gsl::span<TPixelType const> const rows) noexcept = 0;
+
+    /// @brief Finishes writing the image.
+    ///
+    /// @return True if all rows of the image were written successfully, false otherwise.
+    /// @remarks This method has to be called after begin, regardless of success or failure of writing the rows.
+    virtual bool end() noexcept = 0;
+};
+
+/// @brief Writes the result of the given transformer to the given writer, row by row.
+///
+/// @tparam TPixelType The pixel type of transformer and writer.
+/// @param transformer The transformer to take the pixels from.
+/// @param writer The writer to write the image with.
+/// @param rowsPerBatch The number of rows to transform before handing them to the writer.
+/// @return True if the image was written, false otherwise.
+/// @remarks Only rowsPerBatch rows of the image are kept in memory at any time. Like Image::executeAndIngest, the
+///          transformer is reset first and transformers with dimensions of area 0 are rejected before writing.
+template <Pixel TPixelType>
+bool writeTransformed(IImageTransformer<TPixelType>  &transformer,
+                      IImageStreamWriter<TPixelType> &writer,
+                      size_t const                    rowsPerBatch = 16U) noexcept
+{
+    if ((rowsPerBatch == 0U) || !transformer.reset())
+    {
+        return false;
+    }
+    auto const dimensions = transformer.dimensions();
+    if (dimensions.area() == 0U)
+    {
+        return false;
+    }
+    std::vector<TPixelType> rows(dimensions.width * rowsPerBatch);
+
+    auto   success   = writer.begin(dimensions);
+    size_t remaining = dimensions.area();
+    for (size_t row = 0U; success && (row < dimensions.height); row += rowsPerBatch)
+    {
+        auto const batch = gsl::span<TPixelType>{rows}.subspan(
+            0U, dimensions.width * std::min<size_t>(rowsPerBatch, dimensions.height - row));
+        for (auto &pixel : batch)
+        {
+            // like Image::executeAndIngest, the transformer may only signal the end on the last pixel
+            --remaining;
+            if (!transformer.transform(pixel) && (remaining != 0U))
+            {
+                success = false;
+                break;
+            }
+        }
+        success = success && writer.writeRows(batch);
+    }
+    auto const ended = writer.end();
+    return success && ended;
+}
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_COMMON_IIMAGESTREAMWRITER_HPP
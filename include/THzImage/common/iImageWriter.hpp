@@ -15,6 +15,11 @@ namespace Terrahertz {
 template <Pixel TPixelType>
 class Image;
 
+/// @brief Forward declaration of SharedImage for convenience function writeContentOf.
+/// @tparam TPixelType The type of pixel used by the image.
+template <Pixel TPixelType>
+class SharedImage;
+
 /// @brief Interface for all classes writing images.
 ///
 /// @tparam TPixelType The pixel type of the writer.
@@ -34,6 +39,15 @@ public:
     /// @return True if image was writing was successful, false otherwise.
     [[nodiscard]] bool writeContentOf(Image<TPixelType> const &buffer) noexcept { return buffer.writeTo(this); }
 
+    /// @brief Writes the content of the given shared image.
+    ///
+    /// @param image The shared image whos content to write.
+    /// @return True if image was writing was successful, false otherwise.
+    [[nodiscard]] bool writeContentOf(SharedImage<TPixelType> const &image) noexcept
+    {
+        return image && image->writeTo(this);
+    }
+
     /// @brief Is called by the image to initialize the writing process.
     ///
     /// @return True if init was successful, false otherwise.
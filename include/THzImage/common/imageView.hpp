@@ -14,9 +14,9 @@ namespace Terrahertz {
 /// @brief A view into a certain region of an image or pixel buffer.
 /// Doubles as the starting point of a IImageTransformer chain.
 ///
-/// @tparam TValueType The type of pixel value for this view.
+/// @tparam TValueType The type of pixel value for this view, const qualified for read only views.
 template <typename TValueType>
-class ImageView : public IImageTransformer<TValueType>
+class ImageView : public IImageTransformer<std::remove_cv_t<TValueType>>
 {
 public:
     /// @brief The type of this iterator.
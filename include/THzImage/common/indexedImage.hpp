@@ -0,0 +1,119 @@
+#ifndef THZ_IMAGE_COMMON_INDEXEDIMAGE_HPP
+#define THZ_IMAGE_COMMON_INDEXEDIMAGE_HPP
+
+#include "THzCommon/math/rectangle.hpp"
+#include "image.hpp"
+#include "pixel.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Class representing raster based images using one byte per pixel, an index into a palette of colors.
+///
+/// @remarks Pixels are stored Left to Right, Top to Bottom. Compared to an image using BGRAPixel only a quarter of
+///          the memory is needed, which makes it a good fit for keeping many frames with a limited amount of colors.
+class IndexedImage
+{
+public:
+    /// @brief The maximum number of colors in the palette.
+    static constexpr size_t MaxColors{256U};
+
+    /// @brief Default initializes a new indexed image.
+    IndexedImage() noexcept = default;
+
+    /// @brief Returns the dimensions of the image.
+    ///
+    /// @return The dimensions of the image.
+    [[nodiscard]] Rectangle const &dimensions() const noexcept { return _dimensions; }
+
+    /// @brief Sets the new dimensions of the image and resizes the internal buffer.
+    ///
+    /// @param dim The new dimensions of the image.
+    /// @return True if the image was resized correctly, false otherwise.
+    /// @remarks This operation scrambles the currently held indices.
+    [[nodiscard]] bool setDimensions(Rectangle const &dim) noexcept;
+
+    /// @brief Returns the palette of the image.
+    ///
+    /// @return The palette of the image.
+    [[nodiscard]] gsl::span<BGRAPixel const> palette() const noexcept
+    {
+        return gsl::span<BGRAPixel const>{_palette}.subspan(0U, _colors);
+    }
+
+    /// @brief Sets the palette of the image.
+    ///
+    /// @param palette The new palette.
+    /// @return True if the palette was set, false if it contains more than MaxColors colors.
+    [[nodiscard]] bool setPalette(gsl::span<BGRAPixel const> const palette) noexcept;
+
+    /// @brief Returns the indices of the image.
+    ///
+    /// @return The indices of the image.
+    [[nodiscard]] gsl::span<std::uint8_t const> indices() const noexcept { return _indices; }
+
+    /// @brief Returns the indices of the image.
+    ///
+    /// @return The indices of the image.
+    [[nodiscard]] gsl::span<std::uint8_t> indices() noexcept { return _indices; }
+
+    /// @brief Index operator of the image for retrieving the palette index of a pixel.
+    ///
+    /// @param index The index of the pixel to return.
+    /// @return The palette index of the pixel.
+    [[nodiscard]] std::uint8_t &operator[](size_t const index) noexcept { return _indices[index]; }
+
+    /// @brief Index operator of the image for retrieving the palette index of a pixel.
+    ///
+    /// @param index The index of the pixel to return.
+    /// @return The palette index of the pixel.
+    [[nodiscard]] std::uint8_t operator[](size_t const index) const noexcept { return _indices[index]; }
+
+    /// @brief Checks if the given image is equal to this image.
+    ///
+    /// @param other The other image to compare.
+    /// @return True if dimensions, palette and indices are equal, false otherwise.
+    [[nodiscard]] bool operator==(IndexedImage const &other) const noexcept;
+
+    /// @brief Converts the given image, selecting a palette of up to 255 colors for it.
+    ///
+    /// @param image The image to convert.
+    /// @param dither True to apply ordered dithering, false to map each pixel to the closest color.
+    /// @param exact True to search the closest colors for each pixel instead of looking them up in the inverse
+    ///              colormap, slower but with a smaller color error.
+    /// @return True if the image was converted, false if it is empty.
+    /// @remarks Uses the color reduction of the GIF format. If the image contains pixels with an alpha of 0 they are
+    ///          mapped to an additional, fully transparent color at the end of the palette.
+    [[nodiscard]] bool convertFrom(Image<BGRAPixel> const &image,
+                                   bool const              dither = false,
+                                   bool const              exact  = false) noexcept;
+
+    /// @brief Expands the image into the given image by looking up the colors in the palette.
+    ///
+    /// @param image The image to store the result in.
+    /// @return True if the image was expanded, false otherwise.
+    /// @remarks Indices outside of the palette result in transparent black pixels.
+    [[nodiscard]] bool expandInto(Image<BGRAPixel> &image) const noexcept;
+
+private:
+    /// @brief The dimensions of the image.
+    Rectangle _dimensions{};
+
+    /// @brief The number of colors in the palette.
+    size_t _colors{};
+
+    /// @brief The palette of the image.
+    std::array<BGRAPixel, MaxColors> _palette{};
+
+    /// @brief The palette index of each pixel.
+    std::vector<std::uint8_t> _indices{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_COMMON_INDEXEDIMAGE_HPP
@@ -0,0 +1,99 @@
+#ifndef THZ_IMAGE_COMMON_SHAREDIMAGE_HPP
+#define THZ_IMAGE_COMMON_SHAREDIMAGE_HPP
+
+#include "image.hpp"
+#include "pixel.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace Terrahertz {
+
+/// @brief Reference counted handle to an image that can no longer be changed once it has been published.
+///
+/// @tparam TPixelType The type of pixel used by the image.
+/// @remarks Copying the handle only increases the reference count, the image data itself is never copied.
+///          Once the last handle is released the image is freed or, if it came from an ImagePool, handed back
+///          to the pool for reuse.
+template <Pixel TPixelType>
+class SharedImage
+{
+public:
+    /// @brief Shortcut to the type of image the handle refers to.
+    using ImageType = Image<TPixelType>;
+
+    /// @brief Initializes a new empty handle.
+    SharedImage() noexcept = default;
+
+    /// @brief Initializes a new handle taking over the given shared image.
+    ///
+    /// @param image The image to refer to.
+    explicit SharedImage(std::shared_ptr<ImageType const> image) noexcept : _image{std::move(image)} {}
+
+    /// @brief Creates a handle referring to an image owned by someone else.
+    ///
+    /// @param image The image to refer to.
+    /// @return The handle to the image.
+    /// @remarks The handle does not keep the image alive, the owner has to keep it alive and unchanged as long as
+    ///          the handle or one of its copies is in use.
+    [[nodiscard]] static SharedImage borrow(ImageType const &image) noexcept
+    {
+        // aliasing constructor with an empty owner, results in a shared_ptr that does not manage the image
+        return SharedImage{std::shared_ptr<ImageType const>{std::shared_ptr<void>{}, &image}};
+    }
+
+    /// @brief Creates a handle referring to a copy of the given image.
+    ///
+    /// @param image The image to copy.
+    /// @return The handle to the copy.
+    [[nodiscard]] static SharedImage copyOf(ImageType const &image) noexcept
+    {
+        return SharedImage{std::make_shared<ImageType const>(image)};
+    }
+
+    /// @brief Checks if the handle refers to an image.
+    ///
+    /// @return True if the handle refers to an image, false otherwise.
+    [[nodiscard]] explicit operator bool() const noexcept { return _image != nullptr; }
+
+    /// @brief Provides access to the image.
+    ///
+    /// @return The image the handle refers to.
+    /// @remarks Must not be called on an empty handle.
+    [[nodiscard]] ImageType const &operator*() const noexcept { return *_image; }
+
+    /// @brief Provides access to the image.
+    ///
+    /// @return Pointer to the image the handle refers to.
+    [[nodiscard]] ImageType const *operator->() const noexcept { return _image.get(); }
+
+    /// @brief Returns a pointer to the image.
+    ///
+    /// @return Pointer to the image the handle refers to, nullptr if the handle is empty.
+    [[nodiscard]] ImageType const *get() const noexcept { return _image.get(); }
+
+    /// @brief Returns the number of handles currently referring to the image.
+    ///
+    /// @return The number of handles currently referring to the image.
+    [[nodiscard]] size_t useCount() const noexcept { return static_cast<size_t>(_image.use_count()); }
+
+    /// @brief Releases the image, leaving the handle empty.
+    void reset() noexcept { _image.reset(); }
+
+    /// @brief Checks if both handles refer to the same image.
+    ///
+    /// @param other The other handle.
+    /// @return True if both handles refer to the same image, false otherwise.
+    [[nodiscard]] bool operator==(SharedImage const &other) const noexcept { return _image == other._image; }
+
+private:
+    /// @brief The image the handle refers to.
+    std::shared_ptr<ImageType const> _image{};
+};
+
+/// @brief Using declaration for a handle of an image using BGRAPixel.
+using SharedBGRAImage = SharedImage<BGRAPixel>;
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_COMMON_SHAREDIMAGE_HPP
@@ -85,7 +85,7 @@ private:
     bool _callNext{};
 
     /// @brief The view of the current image.
-    ImageView<TPixelType> _view{};
+    ImageView<TPixelType const> _view{};
 };
 
 } // namespace Terrahertz
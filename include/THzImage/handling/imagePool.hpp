@@ -0,0 +1,108 @@
+#ifndef THZ_IMAGE_HANDLING_IMAGEPOOL_HPP
+#define THZ_IMAGE_HANDLING_IMAGEPOOL_HPP
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/common/pixel.hpp"
+#include "THzImage/common/sharedImage.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Pool of image buffers that are handed out for writing and come back once all shared handles are released.
+///
+/// @tparam TPixelType The type of pixel used by the images.
+/// @remarks The pool can be destroyed while handles are still in use, the images are freed once they are released.
+template <Pixel TPixelType>
+class ImagePool
+{
+public:
+    /// @brief Shortcut to the type of image managed by the pool.
+    using ImageType = Image<TPixelType>;
+
+    /// @brief Initializes a new ImagePool.
+    ///
+    /// @param maxIdleImages The maximum number of released images kept for reuse.
+    ImagePool(size_t const maxIdleImages = 8U) noexcept : _state{std::make_shared<State>()}
+    {
+        _state->maxIdleImages = maxIdleImages;
+    }
+
+    /// @brief Takes an image out of the pool, allocating a new one if there is none left.
+    ///
+    /// @return The image to write into.
+    /// @remarks The image keeps the dimensions and content it had before, reading an image of the same size into
+    ///          it does not need any allocation.
+    [[nodiscard]] std::unique_ptr<ImageType> acquire() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{_state->mutex};
+            if (!_state->idleImages.empty())
+            {
+                auto image = std::move(_state->idleImages.back());
+                _state->idleImages.pop_back();
+                return image;
+            }
+        }
+        return std::make_unique<ImageType>();
+    }
+
+    /// @brief Publishes the given image making it immutable and shareable.
+    ///
+    /// @param image The image to publish.
+    /// @return The handle to the published image, empty if image was nullptr.
+    /// @remarks Once the last copy of the handle is released the image is returned to the pool.
+    [[nodiscard]] SharedImage<TPixelType> publish(std::unique_ptr<ImageType> image) noexcept
+    {
+        if (image == nullptr)
+        {
+            return {};
+        }
+        std::weak_ptr<State> state = _state;
+        return SharedImage<TPixelType>{std::shared_ptr<ImageType const>{
+            image.release(), [state](ImageType const *released) noexcept {
+                std::unique_ptr<ImageType> owned{const_cast<ImageType *>(released)};
+                if (auto const pool = state.lock())
+                {
+                    std::lock_guard<std::mutex> lock{pool->mutex};
+                    if (pool->idleImages.size() < pool->maxIdleImages)
+                    {
+                        pool->idleImages.emplace_back(std::move(owned));
+                    }
+                }
+            }}};
+    }
+
+    /// @brief Returns the number of released images waiting for reuse.
+    ///
+    /// @return The number of released images waiting for reuse.
+    [[nodiscard]] size_t idleImages() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        return _state->idleImages.size();
+    }
+
+private:
+    /// @brief The state of the pool, shared with the deleters of the published images.
+    struct State
+    {
+        /// @brief Mutex protecting the idle images.
+        std::mutex mutex{};
+
+        /// @brief The maximum number of released images kept for reuse.
+        size_t maxIdleImages{};
+
+        /// @brief The images waiting for reuse.
+        std::vector<std::unique_ptr<ImageType>> idleImages{};
+    };
+
+    /// @brief The state of the pool.
+    std::shared_ptr<State> _state;
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_HANDLING_IMAGEPOOL_HPP
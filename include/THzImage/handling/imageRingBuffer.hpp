@@ -5,10 +5,13 @@
 #include "THzImage/common/iImageTransformer.hpp"
 #include "THzImage/common/image.hpp"
 #include "THzImage/common/pixel.hpp"
+#include "THzImage/common/sharedImage.hpp"
+#include "THzImage/handling/imagePool.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace Terrahertz {
@@ -16,6 +19,8 @@ namespace Terrahertz {
 /// @brief A Ringbuffer for image handling.
 ///
 /// @tparam TPixelType The type of pixel used by the image.
+/// @remarks The images are published as SharedImage, handles retrieved using share() stay valid after the buffer
+///          moved on, the buffer then continues with a different image from its pool.
 template <Pixel TPixelType>
 class ImageRingBuffer
 {
@@ -54,13 +59,13 @@ public:
     ///
     /// @param index The index of the image, newest images has index 0, second newest 1 and so on.
     /// @return The image at the given index.
-    [[nodiscard]] Image<TPixelType> &operator[](size_t const index) noexcept { return *_map[index]; }
+    [[nodiscard]] Image<TPixelType> const &operator[](size_t const index) const noexcept { return *_map[index]; }
 
-    /// @brief Provides access to the images in the buffer.
+    /// @brief Shares the image at the given index without copying it.
     ///
     /// @param index The index of the image, newest images has index 0, second newest 1 and so on.
-    /// @return The image at the given index.
-    [[nodiscard]] Image<TPixelType> const &operator[](size_t const index) const noexcept { return *_map[index]; }
+    /// @return The handle to the image at the given index.
+    [[nodiscard]] SharedImage<TPixelType> share(size_t const index) const noexcept { return _map[index]; }
 
     /// @brief Loads the next image either from the reader or the transformer.
     ///
@@ -105,46 +110,45 @@ protected:
     {
         if (_reader != nullptr)
         {
-            if ((!_reader->imagePresent()) || (!_map[_slots - 1U]->readFrom(*_reader)))
+            if (!_reader->imagePresent())
             {
                 return false;
             }
         }
-        else
+        else if (_forwardNext && (_count > 0U))
         {
-            if (_forwardNext && (_count > 0U))
-            {
-                // start calling nextImage after the first image has been processed
-                if (!_transformer->nextImage())
-                {
-                    return false;
-                }
-            }
-            if (!_map[_slots - 1U]->executeAndIngest(*_transformer))
+            // start calling nextImage after the first image has been processed
+            if (!_transformer->nextImage())
             {
                 return false;
             }
         }
-        return true;
+
+        // if nobody else holds the image of the last slot, it goes back into the pool and is reused right away
+        auto &slot = _map[_slots - 1U];
+        slot.reset();
+        auto       image  = _pool.acquire();
+        auto const result = (_reader != nullptr) ? image->readFrom(*_reader) : image->executeAndIngest(*_transformer);
+        slot              = _pool.publish(std::move(image));
+        return result;
     }
 
 private:
     /// @brief Sets up the vectors for the buffer.
     void setup() noexcept
     {
-        _buffer.resize(_slots);
         _map.resize(_slots);
-        for (auto i = 0U; i < _slots; ++i)
+        for (auto &slot : _map)
         {
-            _map[i] = &_buffer[i];
+            slot = _pool.publish(_pool.acquire());
         }
     }
 
-    /// @brief The mapping of the buffer newest to oldest entry.
-    std::vector<Image<TPixelType> *> _map{};
+    /// @brief The pool providing the images of the buffer.
+    ImagePool<TPixelType> _pool{};
 
-    /// @brief The buffer of images.
-    std::vector<Image<TPixelType>> _buffer{};
+    /// @brief The mapping of the buffer newest to oldest entry.
+    std::vector<SharedImage<TPixelType>> _map{};
 
     /// @brief Pointer to the reader used to get new images.
     IImageReader<TPixelType> *_reader{};
@@ -4,99 +4,340 @@
 #include "THzCommon/logging/logging.hpp"
 #include "THzImage/common/iImageWriter.hpp"
 #include "THzImage/common/image.hpp"
+#include "THzImage/common/sharedImage.hpp"
 
-#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace Terrahertz {
 
-/// @brief Uses a given writer to write images asynchronously.
+/// @brief Uses given writers to write images asynchronously.
 ///
 /// @tparam TPixelType The type of pixel used by the images to write.
 template <Pixel TPixelType>
 class AsyncWriter
 {
-    /// @brief Name provider for the THzImage.IO.PNG.Writer class.
+    /// @brief Name provider for the THzImage.IO.AsyncWriter class.
     struct Project
     {
         static constexpr char const *name() noexcept { return "THzImage.IO.AsyncWriter"; }
     };
 
 public:
+    /// @brief The different ways to handle new images if the queue of the writer is full.
+    enum class Backpressure
+    {
+        /// @brief Wait until there is room in the queue.
+        block,
+
+        /// @brief Drop the oldest image in the queue that is not yet being written.
+        /// @remark If all images in the queue are already being written the new image is rejected.
+        dropOldest,
+
+        /// @brief Reject the new image.
+        reject
+    };
+
+    /// @brief Callback informing about the result of writing an image.
+    /// @remarks The callback of a written image is executed by the worker thread that wrote it, the callback of an
+    ///          image dropped by Backpressure::dropOldest is executed by the thread calling write. False signals a
+    ///          failure or a dropped image.
+    using Callback = std::function<void(bool written)>;
+
+    /// @brief Function preparing the writer of a worker thread for a specific image, executed by that thread.
+    using Preparation = std::function<void(IImageWriter<TPixelType> &writer)>;
+
+    /// @brief Factory creating the writer used by a worker thread.
+    using WriterFactory = std::function<std::unique_ptr<IImageWriter<TPixelType>>()>;
+
     /// @brief Initializes a new AsyncWriter using the given writer.
     ///
     /// @param writer The writer to wrap.
-    AsyncWriter(IImageWriter<TPixelType> &writer) noexcept : _writer{writer}
+    /// @param queueDepth The maximum number of images queued or being written.
+    /// @param backpressure The way to handle new images if the queue is full.
+    /// @remarks Defaults to Backpressure::reject, as this wrapper always rejected images while the writer was busy.
+    ///          Writers created by a factory are new, so they default to blocking the caller instead.
+    AsyncWriter(IImageWriter<TPixelType> &writer,
+                size_t const              queueDepth   = 1U,
+                Backpressure const        backpressure = Backpressure::reject) noexcept
+        : _queueDepth{queueDepth}, _backpressure{backpressure}
     {
-        _thread = std::thread([this]() { worker(); });
+        _writers.emplace_back(&writer);
+        start();
     }
 
-    /// @brief Finalizes the AsyncWriter shutting down the internal thread.
+    /// @brief Initializes a new AsyncWriter running the given number of worker threads.
+    ///
+    /// @param factory The factory creating a writer for each worker thread.
+    /// @param workers The number of worker threads.
+    /// @param queueDepth The maximum number of images queued or being written.
+    /// @param backpressure The way to handle new images if the queue is full.
+    /// @remarks Workers for which the factory fails to create a writer are not started.
+    AsyncWriter(WriterFactory const &factory,
+                size_t const         workers,
+                size_t const         queueDepth,
+                Backpressure const   backpressure = Backpressure::block) noexcept
+        : _queueDepth{queueDepth}, _backpressure{backpressure}
+    {
+        for (auto i = 0U; i < workers; ++i)
+        {
+            if (auto writer = factory())
+            {
+                _writers.emplace_back(writer.get());
+                _ownedWriters.emplace_back(std::move(writer));
+            }
+            else
+            {
+                logMessage<LogLevel::Error, Project>("Unable to create writer for worker");
+            }
+        }
+        start();
+    }
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    AsyncWriter(AsyncWriter const &) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    AsyncWriter(AsyncWriter &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    AsyncWriter &operator=(AsyncWriter const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    AsyncWriter &operator=(AsyncWriter &&other) noexcept = delete;
+
+    /// @brief Finalizes the AsyncWriter, writing all queued images before shutting down the worker threads.
     ~AsyncWriter() noexcept
     {
-        _shutdown = true;
-        _newImage.notify_one();
-        _thread.join();
+        {
+            std::lock_guard lock{_mutex};
+            _shutdown = true;
+        }
+        _newImage.notify_all();
+        _queueChanged.notify_all();
+        for (auto &thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    /// @brief Writes the given image using the wrapped writers.
+    ///
+    /// @param image The image to write.
+    /// @param onFinished Callback executed once the image has been written or dropped, see Callback.
+    /// @return True if the image was accepted by the writer, false if the queue is full.
+    /// @remarks The image is not copied, it has to stay alive and unchanged until the writing is finished.
+    bool write(Image<TPixelType> const &image, Callback onFinished = {}) noexcept
+    {
+        return write(SharedImage<TPixelType>::borrow(image), std::move(onFinished));
+    }
+
+    /// @brief Writes the given shared image using the wrapped writers.
+    ///
+    /// @param image The image to write.
+    /// @param onFinished Callback executed once the image has been written or dropped, see Callback.
+    /// @return True if the image was accepted by the writer, false if the queue is full.
+    /// @remarks The writer keeps the image alive until the writing is finished, the caller may release it right away.
+    bool write(SharedImage<TPixelType> image, Callback onFinished = {}) noexcept
+    {
+        return write(std::move(image), Preparation{}, std::move(onFinished));
     }
 
-    /// @brief Writes the given image using the wrapped writer.
+    /// @brief Writes the given shared image using the wrapped writers, preparing the writer first.
     ///
     /// @param image The image to write.
-    /// @return True if the image was accepted by the writer, false if the writer is busy writing the last image.
-    bool write(Image<TPixelType> const &image) noexcept
+    /// @param prepare Function preparing the writer right before it writes the image.
+    /// @param onFinished Callback executed once the image has been written or dropped, see Callback.
+    /// @return True if the image was accepted by the writer, false if the queue is full.
+    /// @remarks Allows writers created by a factory to depend on the image, e.g. to write each one to a file of its
+    ///          own. The writer keeps the image alive until the writing is finished.
+    bool write(SharedImage<TPixelType> image, Preparation prepare, Callback onFinished) noexcept
     {
-        if (_image != nullptr)
+        if (!image || _threads.empty())
         {
             return false;
         }
-        std::unique_lock lock{_mutex};
-        if (_image != nullptr)
+        Job dropped{};
         {
-            return false;
+            std::unique_lock lock{_mutex};
+            if (isFull())
+            {
+                switch (_backpressure)
+                {
+                case Backpressure::block:
+                    _queueChanged.wait(lock, [this]() { return !isFull() || _shutdown; });
+                    if (_shutdown)
+                    {
+                        return false;
+                    }
+                    break;
+                case Backpressure::dropOldest:
+                    if (_queue.empty())
+                    {
+                        return false;
+                    }
+                    dropped = std::move(_queue.front());
+                    _queue.pop_front();
+                    break;
+                case Backpressure::reject:
+                    return false;
+                }
+            }
+            _queue.emplace_back(Job{std::move(image), std::move(prepare), std::move(onFinished)});
         }
-        _image = &image;
-        lock.unlock();
         _newImage.notify_one();
+        if (dropped.onFinished)
+        {
+            dropped.onFinished(false);
+        }
         return true;
     }
 
+    /// @brief Writes the given shared image using the wrapped writers.
+    ///
+    /// @param image The image to write.
+    /// @return Future providing the result of writing the image, false if the image was rejected or dropped.
+    [[nodiscard]] std::future<bool> submit(SharedImage<TPixelType> image) noexcept
+    {
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future  = promise->get_future();
+        if (!write(std::move(image), [promise](bool const written) { promise->set_value(written); }))
+        {
+            promise->set_value(false);
+        }
+        return future;
+    }
+
+    /// @brief Returns the number of images queued or being written.
+    ///
+    /// @return The number of images queued or being written.
+    [[nodiscard]] size_t pending() const noexcept
+    {
+        std::lock_guard lock{_mutex};
+        return _queue.size() + _inProgress;
+    }
+
+    /// @brief Waits until all queued images have been written.
+    void flush() noexcept
+    {
+        std::unique_lock lock{_mutex};
+        _queueChanged.wait(lock, [this]() { return _queue.empty() && (_inProgress == 0U); });
+    }
+
 private:
-    /// @brief The method for the worker-thread.
-    void worker() noexcept
+    /// @brief An image waiting to be written.
+    struct Job
+    {
+        /// @brief The image to write.
+        SharedImage<TPixelType> image{};
+
+        /// @brief The function preparing the writer for the image.
+        Preparation prepare{};
+
+        /// @brief The callback to execute after writing the image.
+        Callback onFinished{};
+    };
+
+    /// @brief Starts one worker thread per writer.
+    void start() noexcept
+    {
+        if (_queueDepth == 0U)
+        {
+            logMessage<LogLevel::Error, Project>("Queue depth of 0 is not supported, using 1 instead");
+            _queueDepth = 1U;
+        }
+        for (auto *writer : _writers)
+        {
+            _threads.emplace_back([this, writer]() { worker(*writer); });
+        }
+    }
+
+    /// @brief Checks if the queue is full.
+    ///
+    /// @return True if the queue is full, false otherwise.
+    /// @remarks Must be called while holding the mutex.
+    [[nodiscard]] bool isFull() const noexcept { return (_queue.size() + _inProgress) >= _queueDepth; }
+
+    /// @brief The method for the worker-threads.
+    ///
+    /// @param writer The writer used by the worker.
+    void worker(IImageWriter<TPixelType> &writer) noexcept
     {
         std::unique_lock lock{_mutex};
-        while (!_shutdown)
+        while (true)
         {
-            _newImage.wait_for(
-                lock, std::chrono::milliseconds{10U}, [this]() { return (_image != nullptr) || _shutdown; });
-            if (_image != nullptr)
+            _newImage.wait(lock, [this]() { return !_queue.empty() || _shutdown; });
+            if (_queue.empty())
             {
-                if (!_image->writeTo(&_writer))
-                {
-                    logMessage<LogLevel::Error, Project>("Unable to write image");
-                }
-                _image = nullptr;
+                // shutdown is only performed once the queue is empty
+                return;
+            }
+            auto job = std::move(_queue.front());
+            _queue.pop_front();
+            ++_inProgress;
+            lock.unlock();
+
+            if (job.prepare)
+            {
+                job.prepare(writer);
+            }
+            auto const written = job.image->writeTo(&writer);
+            if (!written)
+            {
+                logMessage<LogLevel::Error, Project>("Unable to write image");
             }
+            job.image.reset();
+            if (job.onFinished)
+            {
+                job.onFinished(written);
+            }
+
+            lock.lock();
+            --_inProgress;
+            _queueChanged.notify_all();
         }
     }
 
-    /// @brief Reference to the writer to use.
-    IImageWriter<TPixelType> &_writer{};
+    /// @brief The maximum number of images queued or being written.
+    size_t _queueDepth{};
 
-    /// @brief The current image to write.
-    Image<TPixelType> const *_image{};
+    /// @brief The way to handle new images if the queue is full.
+    Backpressure _backpressure{};
 
-    /// @brief The worker thread.
-    std::thread _thread{};
+    /// @brief The writers used by the worker threads.
+    std::vector<IImageWriter<TPixelType> *> _writers{};
 
-    /// @brief Flag signalling
-    std::atomic_bool _shutdown{false};
+    /// @brief The writers created by the factory.
+    std::vector<std::unique_ptr<IImageWriter<TPixelType>>> _ownedWriters{};
 
-    std::mutex _mutex{};
+    /// @brief The images waiting to be written.
+    std::deque<Job> _queue{};
 
+    /// @brief The number of images currently being written.
+    size_t _inProgress{};
+
+    /// @brief Flag signalling the worker threads to shut down.
+    bool _shutdown{};
+
+    /// @brief Mutex protecting the queue.
+    mutable std::mutex _mutex{};
+
+    /// @brief Signals the worker threads that a new image was queued.
     std::condition_variable _newImage{};
+
+    /// @brief Signals waiting callers that an image left the queue.
+    std::condition_variable _queueChanged{};
+
+    /// @brief The worker threads.
+    std::vector<std::thread> _threads{};
 };
 
 } // namespace Terrahertz
@@ -1,13 +1,89 @@
 #ifndef THZ_IMAGE_IO_AUTOFILEREADER_HPP
 #define THZ_IMAGE_IO_AUTOFILEREADER_HPP
 
+#include "THzCommon/math/rectangle.hpp"
 #include "THzImage/common/iImageReader.hpp"
+#include "THzImage/common/sharedImage.hpp"
+#include "THzImage/io/imageCache.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <thread>
+#include <vector>
 
 namespace Terrahertz::AutoFile {
 
+/// @brief Enumeration of all supported file formats.
+enum class FileFormat
+{
+    /// @brief The format is not supported or could not be determined.
+    Unknown,
+
+    /// @brief Windows bitmap.
+    BMP,
+
+    /// @brief The native frame format.
+    Frame,
+
+    /// @brief Graphics Interchange Format.
+    GIF,
+
+    /// @brief Portable Network Graphics.
+    PNG,
+
+    /// @brief Quite OK Image format.
+    QOI
+};
+
+/// @brief Information about an image file, gathered by only reading the headers.
+struct ImageInfo
+{
+    /// @brief The format of the file.
+    FileFormat format{};
+
+    /// @brief The dimensions of the image [pxl].
+    Rectangle dimensions{};
+
+    /// @brief The number of bits used to store a single pixel inside the file.
+    ///
+    /// @remarks For GIF-files this is the size of the indices of the global color table.
+    std::uint32_t bitsPerPixel{};
+
+    /// @brief The number of frames stored in the file.
+    std::uint32_t frameCount{};
+};
+
+/// @brief An image file found inside a directory, together with its information.
+struct ProbedFile
+{
+    /// @brief The path of the file.
+    std::filesystem::path path{};
+
+    /// @brief The information about the image.
+    ImageInfo info{};
+};
+
+/// @brief Retrieves the information about the given image file without decoding it.
+///
+/// @param path The path of the file to probe.
+/// @return The information about the image, if the file has a supported format.
+/// @remarks Only the headers are read, to count the frames of a GIF-file the image data is skipped.
+[[nodiscard]] std::optional<ImageInfo> probe(std::filesystem::path const &path) noexcept;
+
+/// @brief Retrieves the information about all image files inside the given directory and its sub directories.
+///
+/// @param directorypath The path of the directory to probe.
+/// @param threads The number of threads used for probing the files.
+/// @return The image files of the directory with their information, files of unsupported formats are left out.
+[[nodiscard]] std::vector<ProbedFile>
+probeDirectory(std::filesystem::path const &directorypath,
+               std::uint32_t const          threads = std::thread::hardware_concurrency()) noexcept;
+
 /// @brief File reader that automatically checks the file type and opens the correct one.
+///
+/// @remarks The format is identified by reading the magic bytes at the start of the file once, so only the reader
+///          for the identified format is created.
 class Reader : public IImageReader<BGRAPixel>
 {
 public:
@@ -17,10 +93,10 @@ public:
     /// @brief The extension handling mode of the reader.
     enum class ExtensionMode
     {
-        /// @brief Use extension as a hint but try all other supported formats.
+        /// @brief Use the format identified by the magic bytes of the file, regardless of the extension.
         lenient,
 
-        /// @brief Use only the format hinted by the extension.
+        /// @brief Only read the file if the magic bytes match the format hinted by the extension.
         strict
     };
 
@@ -33,7 +109,10 @@ public:
     ///
     /// @param path The path of the file to open.
     /// @param mode The extension handling mode of the reader.
-    Reader(std::filesystem::path const path, ExtensionMode mode = ExtensionMode::lenient) noexcept;
+    /// @param cache The cache for the decoded images, nullptr to always decode the file.
+    Reader(std::filesystem::path const path,
+           ExtensionMode               mode  = ExtensionMode::lenient,
+           ImageCache                 *cache = nullptr) noexcept;
 
     /// @brief Explicitly deleted to prevent copy construction.
     Reader(Reader const &other) noexcept = delete;
@@ -56,6 +135,12 @@ public:
     /// @param mode The extension handling mode of the reader.
     void reset(std::filesystem::path const path, ExtensionMode mode = ExtensionMode::lenient) noexcept;
 
+    /// @brief Sets the cache for the decoded images.
+    ///
+    /// @param cache The cache for the decoded images, nullptr to always decode the file.
+    /// @remarks Cached images are read without opening the file, in strict mode the magic bytes are still checked.
+    void setCache(ImageCache *cache) noexcept;
+
     /// @brief Checks if the extension of the current file belongs to a supported type.
     ///
     /// @return True if the extension is supported, false otherwise.
@@ -91,6 +176,15 @@ private:
 
     /// @brief Memory to store the inner reader in.
     std::array<std::uint8_t, InnerReaderBufferSize> _innerReaderBuffer{};
+
+    /// @brief The cache for the decoded images.
+    ImageCache *_cache{};
+
+    /// @brief The image taken from the cache by init.
+    SharedImage<BGRAPixel> _cached{};
+
+    /// @brief The key of the file taken by init before opening it, the decoded image is cached under this key.
+    std::optional<ImageCache::Key> _cacheKey{};
 };
 
 } // namespace Terrahertz::AutoFile
@@ -0,0 +1,98 @@
+#ifndef THZ_IMAGE_IO_BMPMAPPEDREADER_HPP
+#define THZ_IMAGE_IO_BMPMAPPEDREADER_HPP
+
+#include "THzImage/common/iImageReader.hpp"
+#include "THzImage/common/image.hpp"
+#include "THzImage/common/imageView.hpp"
+#include "THzImage/common/pixel.hpp"
+#include "THzImage/io/mappedFile.hpp"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Terrahertz::BMP {
+
+/// @brief Reads an image from a memory mapped file using the BitMap format.
+///
+/// @remarks The pixel data of 32 bit top-down files is identical to the buffer of a BGRAImage, so view() exposes
+///          the mapped file directly. Other files are copied on the first call of view().
+class MappedReader : public IImageReader<BGRAPixel>
+{
+public:
+    using IImageReader::readInto;
+
+    /// @brief Initializes a new BMP::MappedReader.
+    ///
+    /// @param filepath The path of the file to read from.
+    MappedReader(std::filesystem::path const filepath) noexcept;
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    MappedReader(MappedReader const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    MappedReader(MappedReader &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    MappedReader &operator=(MappedReader const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    MappedReader &operator=(MappedReader &&other) noexcept = delete;
+
+    /// @brief Finalizes this instance, performing a deinit.
+    ~MappedReader() noexcept;
+
+    /// @brief Checks if the given file can be read as a BMP file.
+    ///
+    /// @return True if the file can be read, false otherwise.
+    bool fileTypeFits() noexcept;
+
+    /// @copydoc IImageReader::imagePresent
+    bool imagePresent() const noexcept override;
+
+    /// @copydoc IImageReader::init
+    bool init() noexcept override;
+
+    /// @copydoc IImageReader::dimensions
+    Rectangle dimensions() const noexcept override;
+
+    /// @copydoc IImageReader::read
+    bool read(gsl::span<BGRAPixel> buffer) noexcept override;
+
+    /// @copydoc IImageReader::deinit
+    void deinit() noexcept override;
+
+    /// @brief Checks if view() exposes the mapped file without copying.
+    ///
+    /// @return True if the file is a 32 bit top-down BMP-file, false otherwise.
+    /// @remarks Only valid after init was successful.
+    [[nodiscard]] bool zeroCopy() const noexcept;
+
+    /// @brief Returns a read only view of the image.
+    ///
+    /// @return The view of the image, empty if init was not successful or copying the image failed.
+    /// @remarks The view is valid until deinit is called.
+    [[nodiscard]] ImageView<BGRAPixel const> view() noexcept;
+
+private:
+    /// @brief The mapped file.
+    MappedFile _file{};
+
+    /// @brief The pixel data of the file.
+    gsl::span<std::uint8_t const> _pixelData{};
+
+    /// @brief The dimensions of the image.
+    Rectangle _dimensions{};
+
+    /// @brief The bit count of the image data.
+    std::uint8_t _bitCount{};
+
+    /// @brief The direction in which the lines are stored in the file.
+    bool _bottomUp{};
+
+    /// @brief Copy of the image for files that can not be exposed directly.
+    BGRAImage _copy{};
+};
+
+} // namespace Terrahertz::BMP
+
+#endif // !THZ_IMAGE_IO_BMPMAPPEDREADER_HPP
@@ -1,15 +1,19 @@
 #ifndef THZ_IMAGE_IO_BMPWRITER_HPP
 #define THZ_IMAGE_IO_BMPWRITER_HPP
 
+#include "THzImage/common/iImageStreamWriter.hpp"
 #include "THzImage/common/iImageWriter.hpp"
 #include "THzImage/common/pixel.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <vector>
 
 namespace Terrahertz::BMP {
 
 /// @brief Writes an image to a file using the BitMap format.
-class Writer : public IImageWriter<BGRAPixel>
+class Writer : public IImageWriter<BGRAPixel>, public IImageStreamWriter<BGRAPixel>
 {
 public:
     using IImageWriter::writeContentOf;
@@ -29,12 +33,41 @@ public:
     /// @copydoc IImageWriter::deinit
     void deinit() noexcept override;
 
+    /// @copydoc IImageStreamWriter::begin
+    /// @remarks Streamed images are stored top-down, as the rows arrive starting with the top row.
+    bool begin(Rectangle const &dimensions) noexcept override;
+
+    /// @copydoc IImageStreamWriter::writeRows
+    bool writeRows(gsl::span<BGRAPixel const> const rows) noexcept override;
+
+    /// @copydoc IImageStreamWriter::end
+    bool end() noexcept override;
+
 private:
+    /// @brief Writes a single line of the image to the given stream.
+    ///
+    /// @param stream The stream to write to.
+    /// @param line The line to write.
+    /// @return True if the line was written, false otherwise.
+    bool writeLine(std::ofstream &stream, gsl::span<BGRAPixel const> const line) noexcept;
+
     /// @brief The path to write the BMP-File to.
     std::filesystem::path const _filepath;
 
     /// @brief The bit count of the image (24 or 32).
     uint8_t const _bitCount;
+
+    /// @brief Buffer for packing a line of a 24 bit image, including the padding.
+    std::vector<std::uint8_t> _lineBuffer{};
+
+    /// @brief The stream of the image being written row by row.
+    std::ofstream _stream{};
+
+    /// @brief The dimensions of the image being written row by row.
+    Rectangle _streamDimensions{};
+
+    /// @brief The number of rows written to the stream.
+    std::uint32_t _rowsWritten{};
 };
 
 } // namespace Terrahertz::BMP
@@ -0,0 +1,150 @@
+#ifndef THZ_IMAGE_IO_FRAMEFORMAT_HPP
+#define THZ_IMAGE_IO_FRAMEFORMAT_HPP
+
+#include "THzImage/common/pixel.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <gsl/gsl>
+
+namespace Terrahertz::Frame {
+
+/// @brief Tags identifying the pixel type stored in a frame file.
+enum class PixelTag : std::uint8_t
+{
+    /// @brief The pixel type can not be stored in a frame file.
+    unknown = 0U,
+
+    /// @brief The file contains BGRAPixels.
+    bgra = 1U,
+
+    /// @brief The file contains HSVAPixels.
+    hsva = 2U,
+
+    /// @brief The file contains MiniHSVPixels.
+    miniHSV = 3U
+};
+
+/// @brief Returns the tag of the given pixel type.
+///
+/// @tparam TPixelType The pixel type to return the tag for.
+/// @return The tag of the pixel type.
+template <Pixel TPixelType>
+[[nodiscard]] constexpr PixelTag pixelTagOf() noexcept
+{
+    if constexpr (std::same_as<TPixelType, BGRAPixel>)
+    {
+        return PixelTag::bgra;
+    }
+    else if constexpr (std::same_as<TPixelType, HSVAPixel>)
+    {
+        return PixelTag::hsva;
+    }
+    else if constexpr (std::same_as<TPixelType, MiniHSVPixel>)
+    {
+        return PixelTag::miniHSV;
+    }
+    else
+    {
+        return PixelTag::unknown;
+    }
+}
+
+/// @brief Returns the size of the pixel type identified by the given tag.
+///
+/// @param tag The tag of the pixel type.
+/// @return The size of the pixel type [byte], 0 if the tag is unknown.
+[[nodiscard]] constexpr size_t pixelSizeOf(PixelTag const tag) noexcept
+{
+    switch (tag)
+    {
+    case PixelTag::bgra:
+        return sizeof(BGRAPixel);
+    case PixelTag::hsva:
+        return sizeof(HSVAPixel);
+    case PixelTag::miniHSV:
+        return sizeof(MiniHSVPixel);
+    default: // PixelTag::unknown
+        return 0U;
+    }
+}
+
+/// @brief Concept for pixel types that can be stored in a frame file.
+template <typename T>
+concept FramePixel = Pixel<T> && (pixelTagOf<T>() != PixelTag::unknown);
+
+/// @brief The header at the start of each frame file.
+///
+/// @remarks The pixel data follows at dataOffset, which is aligned to DataAlignment so a mapped file can be
+///          accessed as an array of pixels. All values are stored in the byte order of the writing machine.
+struct Header
+{
+    /// @brief The magic bytes "THzF" identifying the file.
+    static constexpr std::uint32_t MagicBytes{0x467A4854U};
+
+    /// @brief The version of the format written by this library.
+    static constexpr std::uint8_t CurrentVersion{1U};
+
+    /// @brief The alignment of the pixel data inside the file [byte].
+    static constexpr std::uint32_t DataAlignment{64U};
+
+    /// @brief The magic bytes identifying the file.
+    std::uint32_t magic{MagicBytes};
+
+    /// @brief The version of the format.
+    std::uint8_t version{CurrentVersion};
+
+    /// @brief The type of the stored pixels.
+    PixelTag pixelTag{};
+
+    /// @brief The size of a single pixel [byte].
+    std::uint8_t pixelSize{};
+
+    /// @brief Reserved for future use, always 0.
+    std::uint8_t reserved{};
+
+    /// @brief The width of the image [pixel].
+    std::uint32_t width{};
+
+    /// @brief The height of the image [pixel].
+    std::uint32_t height{};
+
+    /// @brief The offset of the pixel data from the start of the file [byte].
+    std::uint32_t dataOffset{DataAlignment};
+
+    /// @brief The CRC-32 of the pixel data.
+    std::uint32_t checksum{};
+
+    /// @brief The size of the pixel data [byte].
+    std::uint64_t dataSize{};
+};
+static_assert(sizeof(Header) == 32U, "Frame::Header is not packed as expected");
+static_assert(sizeof(Header) <= Header::DataAlignment, "Frame::Header does not fit in front of the data");
+
+/// @brief Calculates the checksum of the given data.
+///
+/// @param data The data to calculate the checksum of.
+/// @return The CRC-32 of the data.
+[[nodiscard]] std::uint32_t checksum(gsl::span<std::uint8_t const> const data) noexcept;
+
+/// @brief Checks if the given header is valid for a file of the given size.
+///
+/// @param header The header to check.
+/// @param fileSize The size of the file the header was read from [byte].
+/// @return Nullptr if the header is valid, the description of the problem otherwise.
+[[nodiscard]] char const *checkHeader(Header const &header, size_t const fileSize) noexcept;
+
+/// @brief Writes a frame file.
+///
+/// @param filepath The path of the file to write.
+/// @param header The header of the file, the checksum has to be set already.
+/// @param data The pixel data of the file.
+/// @return True if the file was written, false otherwise.
+[[nodiscard]] bool writeFile(std::filesystem::path const &filepath,
+                             Header const                &header,
+                             gsl::span<std::uint8_t const> const data) noexcept;
+
+} // namespace Terrahertz::Frame
+
+#endif // !THZ_IMAGE_IO_FRAMEFORMAT_HPP
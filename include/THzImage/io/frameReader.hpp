@@ -0,0 +1,246 @@
+#ifndef THZ_IMAGE_IO_FRAMEREADER_HPP
+#define THZ_IMAGE_IO_FRAMEREADER_HPP
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzImage/common/iImageReader.hpp"
+#include "THzImage/common/image.hpp"
+#include "THzImage/common/imageView.hpp"
+#include "frameFormat.hpp"
+#include "mappedFile.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gsl/gsl>
+#include <utility>
+
+namespace Terrahertz::Frame {
+
+/// @brief Name provider for the THzImage.IO.Frame.Reader class.
+struct ReaderProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.Frame.Reader"; }
+};
+
+/// @brief Reads an image from a memory mapped file using the uncompressed native frame format.
+///
+/// @tparam TPixelType The type of pixel to read.
+/// @remarks Files storing TPixelType are exposed by view() without copying, files storing another pixel type are
+///          converted directly into TPixelType while reading, the same way Image::convertAndStore does.
+template <FramePixel TPixelType>
+class Reader : public IImageReader<TPixelType>
+{
+public:
+    using IImageReader<TPixelType>::readInto;
+
+    /// @brief Initializes a new Frame::Reader.
+    ///
+    /// @param filepath The path of the file to read from.
+    /// @param verifyChecksum Flag signalling if init shall verify the checksum of the pixel data.
+    Reader(std::filesystem::path const filepath, bool const verifyChecksum = true) noexcept
+        : _verifyChecksum{verifyChecksum}
+    {
+        Logger::globalInstance().addProject<ReaderProject>();
+        _file.open(filepath);
+    }
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    Reader(Reader const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    Reader(Reader &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    Reader &operator=(Reader const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    Reader &operator=(Reader &&other) noexcept = delete;
+
+    /// @brief Finalizes this instance, performing a deinit.
+    ~Reader() noexcept { deinit(); }
+
+    /// @brief Checks if the given file can be read as a frame file.
+    ///
+    /// @return True if the file can be read, false otherwise.
+    bool fileTypeFits() noexcept
+    {
+        auto const data = _file.data();
+        if (data.size() < sizeof(Header))
+        {
+            return false;
+        }
+        Header header{};
+        std::memcpy(&header, data.data(), sizeof(Header));
+        return header.magic == Header::MagicBytes;
+    }
+
+    /// @copydoc IImageReader::imagePresent
+    bool imagePresent() const noexcept override
+    {
+        // file is mapped at construction and will be unmapped on deinit
+        // creating the desired outputs
+        return _file.isOpen();
+    }
+
+    /// @copydoc IImageReader::init
+    bool init() noexcept override
+    {
+        if (!_file.isOpen())
+        {
+            logMessage<LogLevel::Error, ReaderProject>("File could not be mapped");
+            return false;
+        }
+        auto const data = _file.data();
+        if (data.size() < sizeof(Header))
+        {
+            logMessage<LogLevel::Error, ReaderProject>("File too small for header structure");
+            return false;
+        }
+        std::memcpy(&_header, data.data(), sizeof(Header));
+        if (_header.magic != Header::MagicBytes)
+        {
+            // This has trace log level as we might try the reader on other files to check the format
+            logMessage<LogLevel::Trace, ReaderProject>("Given file is not a frame file");
+            return false;
+        }
+        if (auto const problem = checkHeader(_header, data.size()))
+        {
+            logMessage<LogLevel::Error, ReaderProject>(problem);
+            return false;
+        }
+        auto const pixelData = data.subspan(_header.dataOffset, static_cast<size_t>(_header.dataSize));
+        if (_verifyChecksum && (checksum(pixelData) != _header.checksum))
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Checksum of the pixel data does not match");
+            return false;
+        }
+        _pixelData = pixelData;
+        return true;
+    }
+
+    /// @copydoc IImageReader::dimensions
+    Rectangle dimensions() const noexcept override { return Rectangle{_header.width, _header.height}; }
+
+    /// @copydoc IImageReader::read
+    bool read(gsl::span<TPixelType> buffer) noexcept override
+    {
+        if (_pixelData.empty())
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Reader was not initialized");
+            return false;
+        }
+        auto const area = dimensions().area();
+        if (buffer.size() < area)
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Given buffer is too small for the data");
+            return false;
+        }
+        auto const pixels = buffer.subspan(0U, area);
+        switch (_header.pixelTag)
+        {
+        case PixelTag::bgra:
+            convert<BGRAPixel>(pixels);
+            break;
+        case PixelTag::hsva:
+            convert<HSVAPixel>(pixels);
+            break;
+        case PixelTag::miniHSV:
+            convert<MiniHSVPixel>(pixels);
+            break;
+        default: // PixelTag::unknown, rejected by init
+            return false;
+        }
+        return true;
+    }
+
+    /// @copydoc IImageReader::deinit
+    void deinit() noexcept override
+    {
+        _pixelData = {};
+        _copy      = Image<TPixelType>{};
+        _file.close();
+    }
+
+    /// @brief Returns the type of pixel stored in the file.
+    ///
+    /// @return The tag of the stored pixel type.
+    /// @remarks Only valid after init was successful.
+    [[nodiscard]] PixelTag pixelTag() const noexcept { return _header.pixelTag; }
+
+    /// @brief Checks if view() exposes the mapped file without copying.
+    ///
+    /// @return True if the file stores TPixelType, false otherwise.
+    /// @remarks Only valid after init was successful.
+    [[nodiscard]] bool zeroCopy() const noexcept { return _header.pixelTag == pixelTagOf<TPixelType>(); }
+
+    /// @brief Returns a read only view of the image.
+    ///
+    /// @return The view of the image, empty if init was not successful or converting the image failed.
+    /// @remarks The view is valid until deinit is called.
+    [[nodiscard]] ImageView<TPixelType const> view() noexcept
+    {
+        if (_pixelData.empty())
+        {
+            return {};
+        }
+        if (zeroCopy())
+        {
+            // the mapping is page aligned and the data offset is a multiple of Header::DataAlignment
+            return ImageView<TPixelType const>{std::bit_cast<TPixelType const *>(_pixelData.data()), dimensions()};
+        }
+        if (_copy.dimensions() != dimensions())
+        {
+            if (!_copy.setDimensions(dimensions()) ||
+                !read(gsl::span<TPixelType>{&_copy[0U], dimensions().area()}))
+            {
+                logMessage<LogLevel::Error, ReaderProject>("Converting the image failed");
+                _copy = Image<TPixelType>{};
+                return {};
+            }
+        }
+        return std::as_const(_copy).view();
+    }
+
+private:
+    /// @brief Copies the pixel data of the file to the given buffer, converting it if necessary.
+    ///
+    /// @tparam TStoredType The type of pixel stored in the file.
+    /// @param pixels The buffer to copy the pixels to.
+    template <FramePixel TStoredType>
+    void convert(gsl::span<TPixelType> const pixels) const noexcept
+    {
+        if constexpr (std::same_as<TStoredType, TPixelType>)
+        {
+            std::memcpy(pixels.data(), _pixelData.data(), pixels.size_bytes());
+        }
+        else
+        {
+            auto const stored = std::bit_cast<TStoredType const *>(_pixelData.data());
+            for (size_t i = 0U; i < pixels.size(); ++i)
+            {
+                pixels[i] = static_cast<TPixelType>(stored[i]);
+            }
+        }
+    }
+
+    /// @brief The mapped file.
+    MappedFile _file{};
+
+    /// @brief Flag signalling if init shall verify the checksum of the pixel data.
+    bool _verifyChecksum{};
+
+    /// @brief The header of the file.
+    Header _header{};
+
+    /// @brief The pixel data of the file.
+    gsl::span<std::uint8_t const> _pixelData{};
+
+    /// @brief Copy of the image for files storing a different pixel type.
+    Image<TPixelType> _copy{};
+};
+
+} // namespace Terrahertz::Frame
+
+#endif // !THZ_IMAGE_IO_FRAMEREADER_HPP
@@ -0,0 +1,88 @@
+#ifndef THZ_IMAGE_IO_FRAMEWRITER_HPP
+#define THZ_IMAGE_IO_FRAMEWRITER_HPP
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzImage/common/iImageWriter.hpp"
+#include "frameFormat.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <gsl/gsl>
+
+namespace Terrahertz::Frame {
+
+/// @brief Name provider for the THzImage.IO.Frame.Writer class.
+struct WriterProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.Frame.Writer"; }
+};
+
+/// @brief Writes an image to a file using the uncompressed native frame format.
+///
+/// @tparam TPixelType The type of pixel to store.
+/// @remarks The format is meant for caching images between runs, the pixels are stored exactly as they are in memory.
+template <FramePixel TPixelType>
+class Writer : public IImageWriter<TPixelType>
+{
+public:
+    using IImageWriter<TPixelType>::writeContentOf;
+
+    /// @brief Initializes a new Frame::Writer.
+    ///
+    /// @param filepath The path of the file to write to.
+    Writer(std::filesystem::path const filepath) noexcept : _filepath{filepath}
+    {
+        Logger::globalInstance().addProject<WriterProject>();
+    }
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    Writer(Writer const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    Writer(Writer &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    Writer &operator=(Writer const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    Writer &operator=(Writer &&other) noexcept = delete;
+
+    /// @brief Default the destructor.
+    ~Writer() noexcept = default;
+
+    /// @copydoc IImageWriter::init
+    bool init() noexcept override { return !_filepath.empty(); }
+
+    /// @copydoc IImageWriter::write
+    bool write(Rectangle const &dimensions, gsl::span<TPixelType const> const buffer) noexcept override
+    {
+        if ((dimensions.area() == 0U) || (buffer.size() < dimensions.area()))
+        {
+            logMessage<LogLevel::Error, WriterProject>("Buffer does not match the dimensions of the image");
+            return false;
+        }
+        gsl::span<std::uint8_t const> const data{std::bit_cast<std::uint8_t const *>(buffer.data()),
+                                                 dimensions.area() * sizeof(TPixelType)};
+
+        Header header{};
+        header.pixelTag  = pixelTagOf<TPixelType>();
+        header.pixelSize = static_cast<std::uint8_t>(sizeof(TPixelType));
+        header.width     = dimensions.width;
+        header.height    = dimensions.height;
+        header.dataSize  = data.size();
+        header.checksum  = checksum(data);
+        return writeFile(_filepath, header, data);
+    }
+
+    /// @copydoc IImageWriter::deinit
+    void deinit() noexcept override {}
+
+private:
+    /// @brief The path of the file to write to.
+    std::filesystem::path _filepath{};
+};
+
+} // namespace Terrahertz::Frame
+
+#endif // !THZ_IMAGE_IO_FRAMEWRITER_HPP
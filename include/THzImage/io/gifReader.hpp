@@ -4,18 +4,73 @@
 #include "THzImage/common/iImageReader.hpp"
 #include "THzImage/common/pixel.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl>
+#include <vector>
+
 namespace Terrahertz::GIF {
+namespace Internal {
+
+/// @brief Class containing the LZW decompression used by GIF for testing purposes.
+class LZWDecoder
+{
+public:
+    /// @brief Initializes a new LZWDecoder instance.
+    LZWDecoder() noexcept;
+
+    /// @brief Decodes the given data sub-blocks of a GIF image into color indices.
+    ///
+    /// @param minCodeSize The minimum code size stored in front of the sub-blocks, 2 to 8.
+    /// @param data The data sub-blocks, trailing data after the terminating empty sub-block is ignored.
+    /// @param output The buffer for the color indices.
+    /// @return The number of indices written to the output buffer.
+    /// @remarks Decoding stops once the buffer is full, the end code is found or the data is invalid.
+    [[nodiscard]] size_t decode(std::uint8_t const                  minCodeSize,
+                                gsl::span<std::uint8_t const> const data,
+                                gsl::span<std::uint8_t> const       output) noexcept;
+
+private:
+    /// @brief The number of codes of the table.
+    static constexpr size_t TableSize{4096U};
+
+    /// @brief Marks a code without a prefix.
+    static constexpr std::uint16_t NoCode{0xFFFFU};
+
+    /// @brief Restores the single index strings, previous calls with a smaller minimum code size added strings there.
+    void resetRoots() noexcept;
+
+    /// @brief The code of the string without its last index.
+    std::array<std::uint16_t, TableSize> _prefix{};
+
+    /// @brief The last index of the string.
+    std::array<std::uint8_t, TableSize> _suffix{};
+
+    /// @brief The first index of the string.
+    std::array<std::uint8_t, TableSize> _first{};
+
+    /// @brief The length of the string.
+    std::array<std::uint16_t, TableSize> _length{};
+};
+
+} // namespace Internal
 
 /// @brief Reads an image from a file using the GIF format.
+///
+/// @remarks Animations are read frame by frame, imagePresent stays true as long as frames are left. Each frame is
+///          composed onto the previous ones, so every read results in the full image as it is shown.
 class Reader : public IImageReader<BGRAPixel>
 {
 public:
     using IImageReader::readInto;
 
-    /// @brief Initializes a new BMP::Reader.
+    /// @brief Initializes a new GIF::Reader.
     ///
     /// @param filepath The path of the file to read from.
-    Reader(std::string_view const filepath) noexcept;
+    Reader(std::filesystem::path const filepath) noexcept;
 
     /// @brief Explicitly deleted to prevent copy construction.
     Reader(Reader const &other) noexcept = delete;
@@ -32,8 +87,13 @@ public:
     /// @brief Finalizes this instance, performing a deinit.
     ~Reader() noexcept;
 
-    /// @copydoc IImageReader::multipleImages
-    bool multipleImages() const noexcept override;
+    /// @brief Checks if the given file can be read as a GIF file.
+    ///
+    /// @return True if the file can be read, false otherwise.
+    bool fileTypeFits() noexcept;
+
+    /// @copydoc IImageReader::imagePresent
+    bool imagePresent() const noexcept override;
 
     /// @copydoc IImageReader::init
     bool init() noexcept override;
@@ -46,6 +106,57 @@ public:
 
     /// @copydoc IImageReader::deinit
     void deinit() noexcept override;
+
+private:
+    /// @brief Loads the file and parses the header.
+    ///
+    /// @return True if the file is a valid GIF file, false otherwise.
+    bool load() noexcept;
+
+    /// @brief Moves on to the image descriptor of the next frame, parsing the extensions in between.
+    void locateNextFrame() noexcept;
+
+    /// @brief The stream from which to read the file, closed once the file is loaded.
+    std::ifstream _stream{};
+
+    /// @brief The content of the file.
+    std::vector<std::uint8_t> _data{};
+
+    /// @brief The position of the image descriptor of the next frame, 0 if there are no frames left.
+    size_t _position{};
+
+    /// @brief The position of the global color table, 0 if there is none.
+    size_t _globalColorTable{};
+
+    /// @brief The number of colors in the global color table.
+    std::uint16_t _globalColors{};
+
+    /// @brief The dimensions of the image.
+    Rectangle _dimensions{};
+
+    /// @brief The disposal method of the next frame.
+    std::uint8_t _disposal{};
+
+    /// @brief Flag signalling if the next frame uses a transparent color.
+    bool _transparency{};
+
+    /// @brief The transparent color index of the next frame.
+    std::uint8_t _transparentIndex{};
+
+    /// @brief The disposal method of the previous frame.
+    std::uint8_t _previousDisposal{};
+
+    /// @brief The region of the previous frame.
+    Rectangle _previousRegion{};
+
+    /// @brief The composed image.
+    std::vector<BGRAPixel> _canvas{};
+
+    /// @brief The composed image before the previous frame, for restoring it after the frame.
+    std::vector<BGRAPixel> _saved{};
+
+    /// @brief Buffer for the color indices of a frame.
+    std::vector<std::uint8_t> _indices{};
 };
 
 } // namespace Terrahertz::GIF
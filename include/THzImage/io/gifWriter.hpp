@@ -2,12 +2,15 @@
 #define THZ_IMAGE_IO_GIFWRITER_HPP
 
 #include "THzImage/common/iImageWriter.hpp"
+#include "THzImage/common/indexedImage.hpp"
 #include "THzImage/common/pixel.hpp"
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <gsl/gsl>
-#include <string_view>
 #include <vector>
 
 namespace Terrahertz::GIF {
@@ -20,9 +23,18 @@ public:
     /// @brief The target colors, GIF supports 256 but we reserve one for transparency.
     static constexpr size_t TargetColors{255U};
 
+    /// @brief Initializes a new ColorReduction.
+    ///
+    /// @param threads The maximum number of threads to analyze large buffers with.
+    /// @param exact True to search the closest candidates for every color, false to look it up in the inverse
+    ///              colormap.
+    ColorReduction(std::uint32_t const threads = 1U, bool const exact = false) noexcept;
+
     /// @brief Analyzes the given buffer of pixels for selecting the colors.
     ///
     /// @param buffer The buffer of pixels to select the colors for.
+    /// @remarks The colors are counted in a histogram with 5 bits per channel first, the color table is then selected
+    ///          by a median cut on the weighted histogram entries. Large buffers are split between the threads.
     void analyze(gsl::span<BGRAPixel const> const buffer) noexcept;
 
     /// @brief Returns the color table.
@@ -33,10 +45,30 @@ public:
     /// @brief Converts the given color into an index in the color table.
     ///
     /// @param color The color to convert.
-    /// @return The index in the color table that matches the color as closly as possible.
+    /// @return The index of the color in the table closest to the color.
+    /// @remarks Unless the reduction is exact the color is quantized to 5 bits per channel first, a single lookup
+    ///          in the inverse colormap, which may pick a slightly worse color than the search of the candidates.
     std::uint8_t convert(BGRAPixel const &color) const noexcept;
 
 private:
+    /// @brief Converts the given color into an index in the color table searching the closest candidates.
+    ///
+    /// @param color The color to convert.
+    /// @return The index in the color table that matches the color as closly as possible.
+    std::uint8_t convertExact(BGRAPixel const &color) const noexcept;
+
+    /// @brief The number of bits per channel used to index the inverse colormap.
+    static constexpr std::uint32_t InverseBits{5U};
+
+    /// @brief The number of entries for each channel of the inverse colormap.
+    static constexpr size_t InverseLength{1U << InverseBits};
+
+    /// @brief Fills the inverse colormap using the current color table.
+    void updateInverseColormap() noexcept;
+
+    /// @brief Fills the quick access cube using the current color table.
+    void updateQuickAccess() noexcept;
+
     /// @brief The subdivisions of the quick access cube.
     static constexpr size_t QALength{8U};
 
@@ -46,6 +78,12 @@ private:
     /// @brief The length of a quick access slice of the colorspace.
     static constexpr size_t QASlice{256U / QALength};
 
+    /// @brief The maximum number of threads to analyze large buffers with.
+    std::uint32_t _threads{};
+
+    /// @brief Flag signalling that colors are converted by searching the closest candidates.
+    bool _exact{};
+
     /// @brief The number of colors used in the color table.
     std::uint8_t _colorCount{2U};
 
@@ -54,9 +92,14 @@ private:
 
     /// @brief The quick access cube for cutting down lookup time.
     ///
-    /// @remarks Each cell of the cube contains a list of the colors closest to this cell.
+    /// @remarks Each cell of the cube contains a list of the colors closest to this cell, only filled if exact.
     std::array<std::array<std::array<std::array<std::uint8_t, QAEntries>, QALength>, QALength>, QALength>
         _quickAccess{};
+
+    /// @brief The inverse colormap, containing the index of the closest color for each quantized color.
+    ///
+    /// @remarks Indexed by blue, green and red, each reduced to InverseBits. Only filled if not exact.
+    std::array<std::uint8_t, InverseLength * InverseLength * InverseLength> _inverseColormap{};
 };
 
 /// @brief Encapsulates the dithering algorithm.
@@ -92,8 +135,123 @@ private:
     std::array<BGRAPixelFloat *, 6U> _pixel{};
 };
 
+/// @brief Encapsulates the ordered dithering algorithm.
+///
+/// @remarks Instead of carrying the error to the following pixels, a threshold taken from an 8x8 Bayer matrix by
+///          the position of the pixel is added to it. So all pixels can be converted independently and the result
+///          for a pixel at the same position stays the same between the frames of an animation.
+class OrderedDithering
+{
+public:
+    /// @brief Initializes a new OrderedDithering.
+    ///
+    /// @param threads The maximum number of threads to convert large images with.
+    OrderedDithering(std::uint32_t const threads = 1U) noexcept;
+
+    /// @brief Sets the color reduction to use.
+    ///
+    /// @param colorReduction The color reduction instance to use.
+    void setParameters(ColorReduction const &colorReduction) noexcept;
+
+    /// @brief Converts the given color into an index in the color table of the given colorReduction.
+    ///
+    /// @param color The color to convert.
+    /// @param x The column of the pixel in the image.
+    /// @param y The row of the pixel in the image.
+    /// @return The index of the color in the table of the colorReduction.
+    std::uint8_t convert(BGRAPixel color, std::uint32_t const x, std::uint32_t const y) const noexcept;
+
+    /// @brief Converts all pixels of the given image, splitting the rows between the threads for large images.
+    ///
+    /// @param width The width of the image.
+    /// @param buffer The pixels of the image.
+    /// @param indices The buffer for the indices, needs to have the same size as the buffer of pixels.
+    void convert(std::uint32_t const                width,
+                 gsl::span<BGRAPixel const> const buffer,
+                 gsl::span<std::uint8_t> const    indices) const noexcept;
+
+private:
+    /// @brief The maximum number of threads to convert large images with.
+    std::uint32_t _threads{};
+
+    /// @brief The color reduction instance to use.
+    ColorReduction const *_colorReduction{};
+};
+
+/// @brief Class containing the LZW compression used by GIF for testing purposes.
+class LZWEncoder
+{
+public:
+    /// @brief The maximum size of a code [bit].
+    static constexpr std::uint32_t MaxCodeSize{12U};
+
+    /// @brief Returns the maximum number of bytes encode can produce for the given number of indices.
+    ///
+    /// @param indices The number of color indices to encode.
+    /// @return The maximum number of bytes produced, a code of the maximum size for each index plus the clear codes,
+    ///         the sub-block headers and the terminating empty sub-block.
+    [[nodiscard]] static constexpr size_t maxEncodedSize(size_t const indices) noexcept
+    {
+        auto const codes = indices + (indices / 2048U) + 3U;
+        auto const bytes = ((codes * MaxCodeSize) + 7U) / 8U;
+        return bytes + (bytes / 255U) + 2U;
+    }
+
+    /// @brief Encodes the given color indices into the data sub-blocks of a GIF image.
+    ///
+    /// @param minCodeSize The number of bits needed for a color index, 2 to 8.
+    /// @param indices The color indices to encode, all have to be smaller than 2 ^ minCodeSize.
+    /// @param output The buffer for the sub-blocks, needs to hold at least maxEncodedSize(indices.size()).
+    /// @return The number of bytes written to the output buffer, 0 if the parameters are invalid.
+    /// @remarks The output ends with the terminating empty sub-block, the minimum code size is not written.
+    [[nodiscard]] size_t encode(std::uint8_t const                  minCodeSize,
+                                gsl::span<std::uint8_t const> const indices,
+                                gsl::span<std::uint8_t> const       output) noexcept;
+
+private:
+    /// @brief The number of slots in the dictionary, twice the number of codes to keep the probe sequences short.
+    static constexpr size_t DictionarySize{8192U};
+
+    /// @brief Marks an unused slot of the dictionary.
+    static constexpr std::uint32_t EmptySlot{0xFFFFFFFFU};
+
+    /// @brief Removes all strings from the dictionary.
+    void clear() noexcept;
+
+    /// @brief The keys of the strings in the dictionary, the code of the prefix followed by the last index.
+    std::array<std::uint32_t, DictionarySize> _keys{};
+
+    /// @brief The codes of the strings in the dictionary.
+    std::array<std::uint16_t, DictionarySize> _codes{};
+};
+
 } // namespace Internal
 
+/// @brief The different ways of mapping the pixels to the colors of the color table.
+enum class DitheringMode
+{
+    /// @brief Floyd-Steinberg error diffusion, processing the pixels one after another.
+    errorDiffusion,
+
+    /// @brief Ordered dithering using a Bayer matrix, processing the rows in parallel.
+    /// @remark Also applied to the frames of animations, as the result does not change between frames.
+    ordered
+};
+
+/// @brief Options for writing an animation.
+struct AnimationOptions
+{
+    /// @brief The time each frame is shown [1/100 s].
+    std::uint16_t delay{10U};
+
+    /// @brief The number of times the animation is played, 0 meaning forever.
+    std::uint16_t loops{0U};
+
+    /// @brief The factor by which the color error of a frame may exceed the error of the first frame, before the
+    ///        frame gets a color table of its own instead of using the global one.
+    float paletteTolerance{2.0f};
+};
+
 /// @brief Writes an image to a file using the GIF format.
 class Writer : public IImageWriter<BGRAPixel>
 {
@@ -103,18 +261,134 @@ public:
     /// @brief Initializes a new GIF::Writer.
     ///
     /// @param filepath The path to write the GIF-File to.
-    Writer(std::string_view const filepath) noexcept;
+    /// @param mode The way of mapping the pixels to the colors of the color table.
+    /// @param threads The maximum number of threads to analyze the colors and apply ordered dithering with.
+    /// @param exact True to map each color by searching the closest candidates instead of the inverse colormap,
+    ///              slower but with a smaller color error.
+    Writer(std::filesystem::path const filepath,
+           DitheringMode const         mode    = DitheringMode::errorDiffusion,
+           std::uint32_t const         threads = 1U,
+           bool const                  exact   = false) noexcept;
+
+    /// @brief Finalizes this instance, ending the animation if one is being written.
+    ~Writer() noexcept;
 
     /// @copydoc IImageWriter::init
     bool init() noexcept override;
 
     /// @copydoc IImageWriter::write
+    /// @remarks Pixels with an alpha of 0 are written as transparent. While an animation is being written the image
+    ///          is appended as the next frame.
     bool write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept override;
 
+    /// @brief Writes the given indexed image, using its palette as the color table.
+    ///
+    /// @param image The image to write.
+    /// @return True if the image was written, false if it is empty or contains indices outside of its palette.
+    /// @remarks No color reduction or dithering is applied, the first fully transparent color of the palette
+    ///          becomes the transparent color. Indexed images can not be added to an animation.
+    bool write(IndexedImage const &image) noexcept;
+
     /// @copydoc IImageWriter::deinit
     void deinit() noexcept override;
+
+    /// @brief Starts writing an animation, all images written until endAnimation become its frames.
+    ///
+    /// @param options The options for the animation.
+    /// @return True if the animation was started, false if one is already being written or the file can't be opened.
+    /// @remarks The first frame defines the color table and the dimensions of the animation. The following frames
+    ///          only contain the region that changed compared to the previous frame, unchanged pixels inside this
+    ///          region are transparent. Frames are mapped to the closest colors without error diffusion and the
+    ///          alpha channel is ignored.
+    bool beginAnimation(AnimationOptions const &options = {}) noexcept;
+
+    /// @brief Finishes writing the animation.
+    ///
+    /// @return True if the animation contained at least one frame and was written successfully, false otherwise.
+    bool endAnimation() noexcept;
+
+private:
+    /// @brief Writes an image consisting of the given color table and indices to the file.
+    ///
+    /// @param dimensions The dimensions of the image.
+    /// @param colorTable The color table of the image.
+    /// @param indices The color indices of the pixels.
+    /// @param transparency True if the image contains transparent pixels, false otherwise.
+    /// @param transparentIndex The index of the transparent color, may follow the last color of the table.
+    /// @return True if the image was written, false otherwise.
+    bool writeImage(Rectangle const                    &dimensions,
+                    gsl::span<BGRAPixel const> const    colorTable,
+                    gsl::span<std::uint8_t const> const indices,
+                    bool const                          transparency,
+                    std::uint8_t const                  transparentIndex) noexcept;
+
+    /// @brief Appends the given image as the next frame of the animation.
+    ///
+    /// @param dimensions The dimensions of the image.
+    /// @param buffer The pixels of the image.
+    /// @return True if the frame was added, false otherwise.
+    bool writeFrame(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept;
+
+    /// @brief Writes the pending frame to the file.
+    ///
+    /// @return True if the frame was written, false otherwise.
+    bool flushFrame() noexcept;
+
+    /// @brief The path to write the GIF-File to.
+    std::filesystem::path _filepath{};
+
+    /// @brief The color reduction selecting the color table of the image.
+    Internal::ColorReduction _colorReduction{};
+
+    /// @brief The way of mapping the pixels to the colors of the color table.
+    DitheringMode _ditheringMode{};
+
+    /// @brief The dithering converting the pixels to indices of the color table.
+    Internal::Dithering _dithering{};
+
+    /// @brief The ordered dithering converting the pixels to indices of the color table.
+    Internal::OrderedDithering _orderedDithering{};
+
+    /// @brief The LZW encoder compressing the indices.
+    Internal::LZWEncoder _encoder{};
+
+    /// @brief Buffer for the color indices of the image.
+    std::vector<std::uint8_t> _indices{};
+
+    /// @brief Buffer for the content of the file.
+    std::vector<std::uint8_t> _data{};
+
+    /// @brief The stream the animation is written to.
+    std::ofstream _stream{};
+
+    /// @brief The options of the animation being written.
+    AnimationOptions _animation{};
+
+    /// @brief Flag signalling that an animation is being written.
+    bool _animating{};
+
+    /// @brief Flag signalling that writing the animation failed.
+    bool _failed{};
+
+    /// @brief The dimensions of the animation.
+    Rectangle _screen{};
+
+    /// @brief The maximum mean color error of a frame still using the global color table.
+    float _maxPaletteError{};
+
+    /// @brief The previous frame of the animation.
+    std::vector<BGRAPixel> _previous{};
+
+    /// @brief The changed pixels of the current frame, used to build a local color table.
+    std::vector<BGRAPixel> _changed{};
+
+    /// @brief The color reduction for frames needing a local color table.
+    Internal::ColorReduction _localReduction{};
+
+    /// @brief The encoded frame waiting for the next one, so its delay can be extended if nothing changes.
+    std::vector<std::uint8_t> _frame{};
 };
 
 } // namespace Terrahertz::GIF
 
-#endif // !THZ_IMAGE_IO_BMPWRITER_HPP
+#endif // !THZ_IMAGE_IO_GIFWRITER_HPP
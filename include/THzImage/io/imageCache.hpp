@@ -0,0 +1,157 @@
+#ifndef THZ_IMAGE_IO_IMAGECACHE_HPP
+#define THZ_IMAGE_IO_IMAGECACHE_HPP
+
+#include "THzImage/common/pixel.hpp"
+#include "THzImage/common/sharedImage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace Terrahertz {
+
+/// @brief Cache of decoded images, keyed by the path, the size and the modification time of the image file.
+///
+/// @remarks The most recently used images are kept in memory until the byte budget is exhausted. If a spill
+///          directory is given, each cached image is also stored there using the frame format, so later runs can
+///          skip decoding the file entirely. The key is stored after the pixel data of the spilled image and has to
+///          match when it is read back. Spilled images of files that changed since are never used again, but are not
+///          removed either. The cache can be used by multiple threads at the same time.
+class ImageCache
+{
+public:
+    /// @brief Identifies a version of an image file.
+    struct Key
+    {
+        /// @brief The normalized absolute path of the file.
+        std::filesystem::path path{};
+
+        /// @brief The size of the file [byte].
+        std::uintmax_t fileSize{};
+
+        /// @brief The time of the last modification of the file.
+        std::filesystem::file_time_type modified{};
+
+        /// @brief Default comparison.
+        bool operator==(Key const &other) const noexcept = default;
+    };
+
+    /// @brief Initializes a new ImageCache.
+    ///
+    /// @param byteBudget The maximum number of bytes used by the pixels of the images kept in memory.
+    /// @param spillDirectory The directory to store the images in, empty to only keep them in memory.
+    ImageCache(size_t const byteBudget, std::filesystem::path const spillDirectory = {}) noexcept;
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    ImageCache(ImageCache const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    ImageCache(ImageCache &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    ImageCache &operator=(ImageCache const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    ImageCache &operator=(ImageCache &&other) noexcept = delete;
+
+    /// @brief Default destructor.
+    ~ImageCache() noexcept = default;
+
+    /// @brief Determines the key of the given file.
+    ///
+    /// @param path The path of the file.
+    /// @return The key of the file, if the file exists.
+    [[nodiscard]] static std::optional<Key> keyOf(std::filesystem::path const &path) noexcept;
+
+    /// @brief Looks up the decoded image of the given file.
+    ///
+    /// @param path The path of the image file.
+    /// @return The decoded image, empty if the file is not cached or has changed since it was cached.
+    [[nodiscard]] SharedImage<BGRAPixel> find(std::filesystem::path const &path) noexcept;
+
+    /// @brief Looks up the decoded image of the given version of a file.
+    ///
+    /// @param key The key of the image file.
+    /// @return The decoded image, empty if this version of the file is not cached.
+    [[nodiscard]] SharedImage<BGRAPixel> find(Key const &key) noexcept;
+
+    /// @brief Adds the decoded image of the given file to the cache.
+    ///
+    /// @param path The path of the image file.
+    /// @param image The decoded image of the file.
+    /// @remarks Images larger than the byte budget are only spilled. The key is taken after decoding, so if the file
+    ///          may change in between, the key taken before opening it should be inserted instead.
+    void insert(std::filesystem::path const &path, SharedImage<BGRAPixel> image) noexcept;
+
+    /// @brief Adds the decoded image of the given version of a file to the cache.
+    ///
+    /// @param key The key of the image file, taken before the file was opened for decoding.
+    /// @param image The decoded image of the file.
+    /// @remarks Images larger than the byte budget are only spilled.
+    void insert(Key const &key, SharedImage<BGRAPixel> image) noexcept;
+
+    /// @brief Returns the number of images kept in memory.
+    ///
+    /// @return The number of images kept in memory.
+    [[nodiscard]] size_t size() const noexcept;
+
+    /// @brief Returns the number of bytes used by the pixels of the images kept in memory.
+    ///
+    /// @return The number of bytes used by the pixels of the images kept in memory.
+    [[nodiscard]] size_t usedBytes() const noexcept;
+
+    /// @brief Removes all images from memory, keeping the spilled images.
+    void clear() noexcept;
+
+private:
+    /// @brief An image kept in memory.
+    struct Entry
+    {
+        /// @brief The key of the file the image was decoded from.
+        Key key{};
+
+        /// @brief The decoded image.
+        SharedImage<BGRAPixel> image{};
+
+        /// @brief The number of bytes used by the pixels of the image.
+        size_t bytes{};
+    };
+
+    /// @brief Returns the path of the spilled image of the given key.
+    ///
+    /// @param key The key of the file.
+    /// @return The path of the spilled image.
+    [[nodiscard]] std::filesystem::path spillPath(Key const &key) const noexcept;
+
+    /// @brief Adds the given image to memory, evicting the least recently used images if necessary.
+    ///
+    /// @param key The key of the file the image was decoded from.
+    /// @param image The decoded image.
+    void store(Key const &key, SharedImage<BGRAPixel> image) noexcept;
+
+    /// @brief The maximum number of bytes used by the pixels of the images kept in memory.
+    size_t _byteBudget{};
+
+    /// @brief The directory to store the images in, empty to only keep them in memory.
+    std::filesystem::path _spillDirectory{};
+
+    /// @brief Mutex protecting the entries.
+    mutable std::mutex _mutex{};
+
+    /// @brief The images kept in memory, the most recently used first.
+    std::list<Entry> _entries{};
+
+    /// @brief The entries mapped by the normalized path of their file.
+    std::unordered_map<std::filesystem::path::string_type, std::list<Entry>::iterator> _index{};
+
+    /// @brief The number of bytes used by the pixels of the images kept in memory.
+    size_t _usedBytes{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_IO_IMAGECACHE_HPP
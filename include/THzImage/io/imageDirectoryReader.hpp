@@ -2,9 +2,19 @@
 #define THZ_IMAGE_IO_IMAGEDIRECTORYREADER_HPP
 
 #include "THzImage/common/iImageReader.hpp"
+#include "THzImage/common/sharedImage.hpp"
+#include "THzImage/handling/imagePool.hpp"
 #include "THzImage/io/autoFileReader.hpp"
+#include "THzImage/io/imageCache.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace Terrahertz::ImageDirectory {
 
@@ -16,8 +26,7 @@ public:
     enum class Mode
     {
         /// @brief Try to open all files contained within the directory.
-        /// @remark The file extension will be used for the first format tried on the file.
-        /// @remark All known formats will be checked until one succeds.
+        /// @remark The format is determined by the content of the file, regardless of the extension.
         /// @remark If no format fits, the file will be skipped.
         automatic,
 
@@ -32,13 +41,35 @@ public:
         strictExtensionBased
     };
 
+    /// @brief The order in which a reader using worker threads delivers the images.
+    enum class Order
+    {
+        /// @brief Deliver the images in the order of the directory, like a reader without worker threads.
+        directory,
+
+        /// @brief Deliver each image as soon as it has been decoded.
+        completion
+    };
+
+    /// @brief The number of files each worker thread may decode ahead of the delivered image.
+    static constexpr size_t PrefetchPerWorker{2U};
+
     using IImageReader::readInto;
 
     /// @brief Initializes a new ImageDirectory::Reader.
     ///
     /// @param directorypath The path of the directory to read files from.
     /// @param mode The mode the reader is operating in.
-    Reader(std::filesystem::path const directorypath, Mode const mode = Mode::automatic) noexcept;
+    /// @param workers The number of threads decoding the files ahead of time, 0 to decode each file on init.
+    /// @param order The order in which the images are delivered when using worker threads.
+    /// @param cache The cache for the decoded images, nullptr to always decode the files.
+    /// @remarks With worker threads the directory is walked by an additional thread, the decoded images are kept in
+    ///          pooled buffers until they are delivered.
+    Reader(std::filesystem::path const directorypath,
+           Mode const                  mode    = Mode::automatic,
+           std::uint32_t const         workers = 0U,
+           Order const                 order   = Order::directory,
+           ImageCache                 *cache   = nullptr) noexcept;
 
     /// @brief Explicitly deleted to prevent copy construction.
     Reader(Reader const &other) noexcept = delete;
@@ -76,9 +107,53 @@ public:
     std::filesystem::path const &pathOfLastImage() const noexcept;
 
 private:
+    /// @brief The result of decoding a file by a worker thread.
+    struct Decoded
+    {
+        /// @brief The path of the file.
+        std::filesystem::path path{};
+
+        /// @brief The decoded image, empty if the file could not be decoded.
+        SharedImage<BGRAPixel> image{};
+
+        /// @brief Flag signalling that the failure to decode the file shall be reported by init.
+        bool propagateFailure{};
+    };
+
+    /// @brief The method for the thread walking the directory.
+    ///
+    /// @param directorypath The path of the directory to walk.
+    void enumerate(std::filesystem::path const directorypath) noexcept;
+
+    /// @brief The method for the worker threads.
+    void worker() noexcept;
+
+    /// @brief Stops and joins all threads.
+    void stopThreads() noexcept;
+
+    /// @brief Checks if a decoded file can be delivered.
+    ///
+    /// @return True if the next file to deliver has been decoded, false otherwise.
+    /// @remarks Must be called while holding the mutex.
+    [[nodiscard]] bool deliverable() const noexcept;
+
+    /// @brief Checks if all files of the directory have been delivered.
+    ///
+    /// @return True if all files have been delivered, false otherwise.
+    /// @remarks Must be called while holding the mutex.
+    [[nodiscard]] bool exhausted() const noexcept;
+
+    /// @brief Init of the reader using worker threads.
+    ///
+    /// @return True if the next decoded image was taken, false otherwise.
+    bool initParallel() noexcept;
+
     /// @brief The mode the reader is operating in.
     Mode _mode;
 
+    /// @brief The order in which a reader using worker threads delivers the images.
+    Order _order{};
+
     /// @brief The iterator for the directory.
     std::filesystem::recursive_directory_iterator _iterator{};
 
@@ -90,6 +165,48 @@ private:
 
     /// @brief The mode of _innerReader.
     AutoFile::Reader::ExtensionMode _innerReaderMode{};
+
+    /// @brief The cache for the decoded images.
+    ImageCache *_cache{};
+
+    /// @brief The pool providing the buffers for the decoded images.
+    ImagePool<BGRAPixel> _pool{};
+
+    /// @brief The image delivered by the last init of a reader using worker threads.
+    SharedImage<BGRAPixel> _current{};
+
+    /// @brief The maximum number of files enumerated but not yet delivered.
+    size_t _prefetch{};
+
+    /// @brief The files waiting to be decoded, mapped by their position in the directory.
+    std::map<size_t, std::filesystem::path> _pending{};
+
+    /// @brief The decoded files waiting to be delivered, mapped by their position in the directory.
+    std::map<size_t, Decoded> _decoded{};
+
+    /// @brief The number of files found in the directory so far.
+    size_t _enumerated{};
+
+    /// @brief The number of files delivered or skipped.
+    size_t _delivered{};
+
+    /// @brief Flag signalling that the whole directory has been walked.
+    bool _enumerationFinished{};
+
+    /// @brief Flag signalling the threads to shut down.
+    bool _shutdown{};
+
+    /// @brief Mutex protecting the state shared with the threads.
+    mutable std::mutex _mutex{};
+
+    /// @brief Signals that the state shared with the threads has changed.
+    mutable std::condition_variable _changed{};
+
+    /// @brief The thread walking the directory.
+    std::thread _enumerator{};
+
+    /// @brief The threads decoding the files.
+    std::vector<std::thread> _workers{};
 };
 
 } // namespace Terrahertz::ImageDirectory
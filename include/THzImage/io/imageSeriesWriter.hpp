@@ -3,13 +3,22 @@
 
 #include "THzCommon/logging/logging.hpp"
 #include "THzImage/common/iImageWriter.hpp"
+#include "THzImage/common/image.hpp"
+#include "THzImage/common/sharedImage.hpp"
+#include "asyncWriter.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace Terrahertz::ImageSeries {
 
@@ -22,11 +31,23 @@ struct WriterProject
 /// @brief Wrapper for other writers, enabling writing of multiple images.
 ///
 /// @tparam TWrapped The type of the wrapped image writer.
+/// @remarks Besides writing sequentially through the IImageWriter interface, the writer offers a parallel mode
+///          encoding the images on a pool of worker threads, see startParallel().
 template <FileImageWriter TWrapped>
 class Writer : public IImageWriter<typename TWrapped::PixelType>
 {
 public:
-    using IImageWriter<typename TWrapped::PixelType>::writeContentOf;
+    /// @brief Shortcut to the pixel type used by the wrapped writer.
+    using PixelType = typename TWrapped::PixelType;
+
+    /// @brief Callback informing about the result of writing an image in parallel mode.
+    /// @remarks The callback is executed by the worker thread that wrote the image.
+    using Callback = std::function<void(std::uint32_t number, bool written)>;
+
+    /// @brief Function configuring each wrapped writer after it has been created.
+    using Configurator = std::function<void(TWrapped &writer)>;
+
+    using IImageWriter<PixelType>::writeContentOf;
 
     /// @brief Creates a writer using the given filepath as a template.
     ///
@@ -55,18 +76,75 @@ public:
         return Writer(filepath, startNumber, increments);
     }
 
+    /// @brief Sets the function configuring each wrapped writer after it has been created.
+    ///
+    /// @param configurator The function configuring the wrapped writers.
+    /// @remarks Has to be set before starting the parallel mode to also apply to the writers of the worker threads.
+    void configure(Configurator configurator) noexcept { _configurator = std::move(configurator); }
+
+    /// @brief Starts the parallel mode using the given number of worker threads.
+    ///
+    /// @param workers The number of worker threads encoding the images.
+    /// @param queueDepth The maximum number of images queued or being encoded, writeParallel blocks if it is reached.
+    /// @param onFinished Optional callback informing about the result of each image.
+    /// @return True if the parallel mode was started, false if it already runs or the parameters are invalid.
+    /// @remarks The worker threads are run by an AsyncWriter blocking if the queue is full. Each image is encoded by
+    ///          a wrapped writer of its own, so the wrapped writer needs no thread safety.
+    bool startParallel(size_t const workers, size_t const queueDepth, Callback onFinished = {}) noexcept
+    {
+        if (_parallel || (workers == 0U) || (queueDepth == 0U))
+        {
+            logMessage<LogLevel::Error, WriterProject>("Unable to start parallel mode");
+            return false;
+        }
+        _parallel = std::make_unique<Parallel>(workers, queueDepth, std::move(onFinished), _configurator);
+        return true;
+    }
+
+    /// @brief Queues the given image to be written by the worker threads of the parallel mode.
+    ///
+    /// @param image The image to write.
+    /// @return The number assigned to the image, empty if the parallel mode was not started or the image is empty.
+    /// @remarks The number is assigned right away, so the numbering matches the order of the calls regardless of
+    ///          the order the images are finished in. Blocks if the queue is full.
+    std::optional<std::uint32_t> writeParallel(SharedImage<PixelType> image) noexcept
+    {
+        if (!_parallel || !image)
+        {
+            return {};
+        }
+        auto const number = _nextNumber;
+        _nextNumber += _increments;
+        _parallel->enqueue(number, formatPath(number), std::move(image));
+        return number;
+    }
+
+    /// @brief Waits until all images queued in parallel mode have been written.
+    ///
+    /// @return The numbers of all images that failed to be written since the last call, in ascending order.
+    [[nodiscard]] std::vector<std::uint32_t> flushParallel() noexcept
+    {
+        if (!_parallel)
+        {
+            return {};
+        }
+        return _parallel->flush();
+    }
+
     /// @copydoc IImageWriter::init
     bool init() noexcept override
     {
         closeWriter();
-        std::array<char, PathBufferSize + 4U> filepath{};
-        std::snprintf(filepath.data(), filepath.size(), _filepath.data(), _nextNumber);
-        _wrapped = new (_buffer.data()) TWrapped(filepath.data());
+        _wrapped = new (_buffer.data()) TWrapped(formatPath(_nextNumber));
         if (_wrapped == nullptr)
         {
             logMessage<LogLevel::Error, WriterProject>("Creating the writer failed");
             return false;
         }
+        if (_configurator)
+        {
+            _configurator(*_wrapped);
+        }
         return _wrapped->init();
     }
 
@@ -95,6 +173,134 @@ private:
     /// @brief The size of the path buffer.
     static constexpr size_t PathBufferSize{512U};
 
+    /// @brief Writer used by the worker threads of the parallel mode, writing each image to a file of its own.
+    class FileWriter : public IImageWriter<PixelType>
+    {
+    public:
+        /// @brief Initializes a new FileWriter.
+        ///
+        /// @param configurator The function configuring the wrapped writers.
+        FileWriter(Configurator const &configurator) noexcept : _configurator{configurator} {}
+
+        /// @brief Sets the path of the file the next image is written to.
+        ///
+        /// @param filepath The path of the file.
+        void setFilepath(std::filesystem::path filepath) noexcept { _filepath = std::move(filepath); }
+
+        /// @copydoc IImageWriter::init
+        bool init() noexcept override
+        {
+            _wrapped.emplace(_filepath);
+            if (_configurator)
+            {
+                _configurator(*_wrapped);
+            }
+            return _wrapped->init();
+        }
+
+        /// @copydoc IImageWriter::write
+        bool write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept override
+        {
+            return _wrapped && _wrapped->write(dimensions, buffer);
+        }
+
+        /// @copydoc IImageWriter::deinit
+        void deinit() noexcept override
+        {
+            if (_wrapped)
+            {
+                _wrapped->deinit();
+                _wrapped.reset();
+            }
+        }
+
+    private:
+        /// @brief The function configuring the wrapped writers.
+        Configurator const &_configurator;
+
+        /// @brief The path of the file the next image is written to.
+        std::filesystem::path _filepath{};
+
+        /// @brief The writer of the current image.
+        std::optional<TWrapped> _wrapped{};
+    };
+
+    /// @brief The state of the parallel mode.
+    /// @remarks Kept on the heap so the worker threads are not affected by moving the writer.
+    class Parallel
+    {
+    public:
+        /// @brief Initializes the parallel mode starting the worker threads.
+        ///
+        /// @param workers The number of worker threads.
+        /// @param queueDepth The maximum number of images queued or being encoded.
+        /// @param onFinished Callback informing about the result of each image.
+        /// @param configurator The function configuring the wrapped writers.
+        Parallel(size_t const workers,
+                 size_t const queueDepth,
+                 Callback     onFinished,
+                 Configurator configurator) noexcept
+            : _onFinished{std::move(onFinished)},
+              _configurator{std::move(configurator)},
+              _writer{[this]() noexcept { return std::make_unique<FileWriter>(_configurator); },
+                      workers,
+                      queueDepth,
+                      AsyncWriter<PixelType>::Backpressure::block}
+        {}
+
+        /// @brief Queues the given image, waiting for room in the queue if necessary.
+        ///
+        /// @param number The number assigned to the image.
+        /// @param filepath The path of the file to write.
+        /// @param image The image to write.
+        void enqueue(std::uint32_t const number, std::filesystem::path filepath, SharedImage<PixelType> image) noexcept
+        {
+            auto const prepare = [filepath = std::move(filepath)](IImageWriter<PixelType> &writer) noexcept {
+                // all writers of the worker threads are created by the factory above
+                static_cast<FileWriter &>(writer).setFilepath(filepath);
+            };
+            auto const finished = [this, number](bool const written) noexcept {
+                if (!written)
+                {
+                    std::lock_guard lock{_mutex};
+                    _failed.emplace_back(number);
+                }
+                if (_onFinished)
+                {
+                    _onFinished(number, written);
+                }
+            };
+            (void)_writer.write(std::move(image), prepare, finished);
+        }
+
+        /// @brief Waits until all queued images are written.
+        ///
+        /// @return The numbers of the failed images, in ascending order.
+        std::vector<std::uint32_t> flush() noexcept
+        {
+            _writer.flush();
+            std::lock_guard lock{_mutex};
+            std::sort(_failed.begin(), _failed.end());
+            return std::exchange(_failed, {});
+        }
+
+    private:
+        /// @brief Callback informing about the result of each image.
+        Callback _onFinished{};
+
+        /// @brief The function configuring the wrapped writers.
+        Configurator _configurator{};
+
+        /// @brief Mutex protecting the numbers of the failed images.
+        std::mutex _mutex{};
+
+        /// @brief The numbers of the failed images.
+        std::vector<std::uint32_t> _failed{};
+
+        /// @brief The writer running the worker threads, declared last so it is shut down first.
+        AsyncWriter<PixelType> _writer;
+    };
+
     /// @brief Initializes a new ImageSeries::Writer using the given filepath.
     ///
     /// @param filepath The filepath template for the file to write.
@@ -121,6 +327,17 @@ private:
         }
     }
 
+    /// @brief Creates the path of the file with the given number.
+    ///
+    /// @param number The number of the file.
+    /// @return The path of the file.
+    [[nodiscard]] std::filesystem::path formatPath(std::uint32_t const number) const noexcept
+    {
+        std::array<char, PathBufferSize + 4U> filepath{};
+        std::snprintf(filepath.data(), filepath.size(), _filepath.data(), number);
+        return std::filesystem::path{filepath.data()};
+    }
+
     /// @brief Closes the current writer, if one is open.
     void closeWriter() noexcept
     {
@@ -145,6 +362,12 @@ private:
 
     /// @brief The buffer for the wrapped writer.
     std::array<std::uint8_t, sizeof(TWrapped)> _buffer{};
+
+    /// @brief The function configuring each wrapped writer after it has been created.
+    Configurator _configurator{};
+
+    /// @brief The state of the parallel mode, if started.
+    std::unique_ptr<Parallel> _parallel{};
 };
 
 } // namespace Terrahertz::ImageSeries
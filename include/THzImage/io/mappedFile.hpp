@@ -0,0 +1,72 @@
+#ifndef THZ_IMAGE_IO_MAPPEDFILE_HPP
+#define THZ_IMAGE_IO_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gsl/gsl>
+
+namespace Terrahertz {
+
+/// @brief Maps a file into memory for reading, without copying its content.
+class MappedFile
+{
+public:
+    /// @brief Initializes a new MappedFile without mapping a file.
+    MappedFile() noexcept = default;
+
+    /// @brief Explicitly deleted to prevent copy construction.
+    MappedFile(MappedFile const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move construction.
+    MappedFile(MappedFile &&other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent copy assignment.
+    MappedFile &operator=(MappedFile const &other) noexcept = delete;
+
+    /// @brief Explicitly deleted to prevent move assignment.
+    MappedFile &operator=(MappedFile &&other) noexcept = delete;
+
+    /// @brief Finalizes this instance, unmapping the file.
+    ~MappedFile() noexcept;
+
+    /// @brief Maps the given file into memory, unmapping the previous one.
+    ///
+    /// @param filepath The path of the file to map.
+    /// @return True if the file was mapped, false otherwise.
+    /// @remarks The operating system is advised that the file will be read sequentially.
+    bool open(std::filesystem::path const &filepath) noexcept;
+
+    /// @brief Checks if a file is mapped.
+    ///
+    /// @return True if a file is mapped, false otherwise.
+    [[nodiscard]] bool isOpen() const noexcept;
+
+    /// @brief Returns the content of the mapped file.
+    ///
+    /// @return The content of the mapped file, empty if no file is mapped.
+    /// @remarks The content is only valid until the file is closed.
+    [[nodiscard]] gsl::span<std::uint8_t const> data() const noexcept;
+
+    /// @brief Unmaps the file.
+    void close() noexcept;
+
+private:
+    /// @brief Pointer to the start of the mapped file.
+    std::uint8_t const *_data{};
+
+    /// @brief The size of the mapped file [byte].
+    size_t _size{};
+
+#ifdef _WIN32
+    /// @brief The handle of the file.
+    void *_file{};
+
+    /// @brief The handle of the file mapping.
+    void *_mapping{};
+#endif
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_IO_MAPPEDFILE_HPP
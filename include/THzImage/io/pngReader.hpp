@@ -53,6 +53,13 @@ public:
     /// @copydoc IImageReader::read
     bool read(gsl::span<BGRAPixel> buffer) noexcept override;
 
+    /// @brief Reads the next rows of the image, enabling processing the image row by row.
+    ///
+    /// @param buffer The buffer for the rows, its size determines the number of rows to read.
+    /// @return The number of rows read, 0 if all rows have been read or reading failed.
+    /// @remarks Can be used instead of read, after init was successful. Interlaced images can not be read this way.
+    std::uint32_t readRows(gsl::span<BGRAPixel> buffer) noexcept;
+
     /// @copydoc IImageReader::deinit
     void deinit() noexcept override;
 
@@ -61,7 +68,7 @@ private:
     struct Impl;
 
     /// @brief Pointer to the implementation.
-    StaticPImpl<Impl, 40U> _impl{};
+    StaticPImpl<Impl, 48U> _impl{};
 };
 
 } // namespace Terrahertz::PNG
@@ -1,15 +1,73 @@
 #ifndef THZ_IMAGE_IO_PNGWRITER_HPP
 #define THZ_IMAGE_IO_PNGWRITER_HPP
 
+#include "THzImage/common/iImageStreamWriter.hpp"
 #include "THzImage/common/iImageWriter.hpp"
+#include "THzImage/common/indexedImage.hpp"
 #include "THzImage/common/pixel.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 
 namespace Terrahertz::PNG {
 
+/// @brief The filters applied to the rows of the image before compressing them.
+enum class Filter
+{
+    /// @brief Rows are compressed as they are.
+    none,
+
+    /// @brief Each byte is stored as difference to the corresponding byte of the pixel to the left.
+    sub,
+
+    /// @brief Each byte is stored as difference to the corresponding byte of the pixel above.
+    up,
+
+    /// @brief Each byte is stored as difference to the Paeth predictor of the left, upper and upper left pixel.
+    paeth,
+
+    /// @brief The filter is chosen for each row separately, best compression but slowest.
+    adaptive
+};
+
+/// @brief The strategies zlib can use to compress the filtered rows.
+enum class Strategy
+{
+    /// @brief Lets libpng choose the strategy depending on the filter.
+    automatic,
+
+    /// @brief The default strategy of zlib.
+    standard,
+
+    /// @brief Strategy tuned for filtered data, favoring huffman coding over string matching.
+    filtered,
+
+    /// @brief Strategy only matching runs of identical bytes, fast and well suited for screen content.
+    rle
+};
+
+/// @brief Options for compressing the PNG-file.
+struct CompressionOptions
+{
+    /// @brief The zlib compression level [0 - 9], 0 meaning no compression and 9 the best.
+    std::uint8_t level{6U};
+
+    /// @brief The filter applied to the rows before compressing them.
+    Filter filter{Filter::adaptive};
+
+    /// @brief The zlib strategy used to compress the rows.
+    Strategy strategy{Strategy::automatic};
+
+    /// @brief Creates options favoring speed over file size.
+    ///
+    /// @return The options for fast compression.
+    /// @remarks Especially for screen content the files are only a little larger than with the default options.
+    [[nodiscard]] static constexpr CompressionOptions fast() noexcept { return {1U, Filter::sub, Strategy::rle}; }
+};
+
 /// @brief Writes an image to a file using the Portable-Network-Graphics format.
-class Writer : public IImageWriter<BGRAPixel>
+class Writer : public IImageWriter<BGRAPixel>, public IImageStreamWriter<BGRAPixel>
 {
 public:
     using IImageWriter::writeContentOf;
@@ -17,7 +75,26 @@ public:
     /// @brief Initializes a nwe PNGWriter.
     ///
     /// @param filepath The path to write the PNG-File to.
-    Writer(std::filesystem::path const filepath) noexcept;
+    /// @param options The options for compressing the image.
+    /// @param threads The number of threads to encode the image with.
+    /// @remarks Using more than 1 thread, the rows are filtered and compressed in bands on multiple threads, still
+    ///          resulting in a standard PNG file.
+    Writer(std::filesystem::path const filepath,
+           CompressionOptions const    options = {},
+           std::uint32_t const         threads = 1U) noexcept;
+
+    /// @brief Finalizes the writer, finishing an image that is still being streamed.
+    ~Writer() noexcept;
+
+    /// @brief Sets the options for compressing the images written afterwards.
+    ///
+    /// @param options The options for compressing the image.
+    void setCompressionOptions(CompressionOptions const options) noexcept;
+
+    /// @brief Returns the options for compressing the image.
+    ///
+    /// @return The options for compressing the image.
+    [[nodiscard]] CompressionOptions compressionOptions() const noexcept;
 
     /// @copydoc IImageWriter::init
     bool init() noexcept override;
@@ -25,12 +102,49 @@ public:
     /// @copydoc IImageWriter::write
     bool write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept override;
 
+    /// @brief Writes the given indexed image using the palette color type.
+    ///
+    /// @param image The image to write.
+    /// @return True if the image was written, false if it is empty or contains indices outside of its palette.
+    /// @remarks Palettes of up to 16 colors are stored with 1, 2 or 4 bits per pixel. The alpha of the palette colors
+    ///          is stored as well, if any of them is not fully opaque. Always encoded on the calling thread.
+    bool write(IndexedImage const &image) noexcept;
+
     /// @copydoc IImageWriter::deinit
     void deinit() noexcept override;
 
+    /// @copydoc IImageStreamWriter::begin
+    /// @remarks Streamed images are always encoded on the calling thread.
+    bool begin(Rectangle const &dimensions) noexcept override;
+
+    /// @copydoc IImageStreamWriter::writeRows
+    bool writeRows(gsl::span<BGRAPixel const> const rows) noexcept override;
+
+    /// @copydoc IImageStreamWriter::end
+    bool end() noexcept override;
+
 private:
+    /// @brief The state of libpng while an image is being written, defined in the source file to hide libpng.
+    struct Stream;
+
+    /// @brief Encodes the image on multiple threads, without using libpng.
+    ///
+    /// @param dimensions The dimensions of the image.
+    /// @param buffer The buffer containing the image data.
+    /// @return True if the image was written, false otherwise.
+    bool writeParallel(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept;
+
     /// @brief The path to write the PNG-File to.
     std::filesystem::path const _filepath;
+
+    /// @brief The options for compressing the image.
+    CompressionOptions _options{};
+
+    /// @brief The number of threads to encode the image with.
+    std::uint32_t _threads{};
+
+    /// @brief The state of the image being written, nullptr if no image is being written.
+    std::unique_ptr<Stream> _stream{};
 };
 
 } // namespace Terrahertz::PNG
@@ -44,8 +44,17 @@ public:
     /// @param buffer The buffer containing the compressed data.
     /// @return The amount of bytes read from the buffer.
     /// @remarks Reading will stop once the given buffer for the image data is full.
+    /// @remarks Meant for streaming the data, use decompress if all the data is available at once.
     size_t insertDataChunk(gsl::span<std::uint8_t const> const buffer) noexcept;
 
+    /// @brief Decompresses the given data in a single pass, starting from the initial state.
+    ///
+    /// @param data The compressed data.
+    /// @param buffer The buffer for the decompressed data.
+    /// @return The number of pixels written to the buffer.
+    /// @remarks Decompression stops once the buffer is full or the data ends, trailing data is ignored.
+    static size_t decompress(gsl::span<std::uint8_t const> const data, gsl::span<BGRAPixel> const buffer) noexcept;
+
 private:
     /// @brief The remaining image buffer to put the decoded data into.
     gsl::span<BGRAPixel> _remainingImageBuffer{};
@@ -73,7 +82,9 @@ public:
     /// @brief Initializes a new QOI::Reader.
     ///
     /// @param filepath The path of the file to read from.
-    Reader(std::filesystem::path const filepath) noexcept;
+    /// @param threads The number of threads to decompress files using the chunk index extension with.
+    /// @remarks Plain QOI-Files are always decompressed using a single thread.
+    Reader(std::filesystem::path const filepath, std::uint32_t const threads = 1U) noexcept;
 
     /// @brief Explicitly deleted to prevent copy construction.
     Reader(Reader const &other) noexcept = delete;
@@ -117,8 +128,18 @@ private:
     /// @brief The dimensions of the image.
     Rectangle _dimensions{};
 
+    /// @brief Decompresses the chunks of a file using the chunk index extension.
+    ///
+    /// @param data The image data following the header.
+    /// @param buffer The buffer for the decompressed data.
+    /// @return True if the data contained a valid chunk index and all chunks were decompressed, false otherwise.
+    bool readChunked(gsl::span<std::uint8_t const> const data, gsl::span<BGRAPixel> const buffer) noexcept;
+
     /// @brief The decompressor for the image data.
     Internal::Decompressor _decompressor{};
+
+    /// @brief The number of threads to decompress chunked files with.
+    std::uint32_t _threads{};
 };
 
 } // namespace Terrahertz::QOI
@@ -1,12 +1,16 @@
 #ifndef THZ_IMAGE_IO_QOIWRITER_HPP
 #define THZ_IMAGE_IO_QOIWRITER_HPP
 
+#include "THzImage/common/iImageStreamWriter.hpp"
 #include "THzImage/common/iImageWriter.hpp"
 #include "THzImage/common/pixel.hpp"
 
 #include <array>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <gsl/gsl>
+#include <vector>
 
 namespace Terrahertz::QOI {
 namespace Internal {
@@ -21,12 +25,36 @@ public:
     /// @brief Resets the compressor to the initial state.
     void reset() noexcept;
 
+    /// @brief Returns the maximum number of bytes compress can produce for the given number of pixels.
+    ///
+    /// @param pixels The number of pixels to compress.
+    /// @return The maximum number of bytes produced, an OpRGBA for each pixel plus a pending OpRun.
+    [[nodiscard]] static constexpr size_t maxCompressedSize(size_t const pixels) noexcept { return pixels * 5U + 1U; }
+
     /// @brief Compresses the next pixel of the image.
     ///
     /// @param pixel The next pixel to compress.
     /// @return The next compressed bytes.
     [[nodiscard]] gsl::span<std::uint8_t const> nextPixel(BGRAPixel const &pixel) noexcept;
 
+    /// @brief Compresses the given pixels of the image into the given buffer.
+    ///
+    /// @param pixels The next pixels to compress.
+    /// @param output The buffer for the compressed bytes, needs to hold at least maxCompressedSize(pixels.size()).
+    /// @return The number of bytes written to the output buffer, 0 if the buffer is too small.
+    /// @remarks Equivalent to calling nextPixel for each pixel, a run at the end stays pending until flush.
+    [[nodiscard]] size_t compress(gsl::span<BGRAPixel const> const pixels, gsl::span<std::uint8_t> const output) noexcept;
+
+    /// @brief Compresses the given pixels as a chunk that can be decompressed without knowing the previous data.
+    ///
+    /// @param pixels The pixels of the chunk.
+    /// @param output The buffer for the compressed bytes, needs to hold at least maxCompressedSize(pixels.size()) + 1.
+    /// @return The number of bytes written to the output buffer, 0 if pixels is empty or the buffer is too small.
+    /// @remarks The chunk starts with an OpRGBA and never refers to colors of previous chunks, so a sequence of
+    ///          chunks is a valid QOI data stream as well. This will also reset the compressor.
+    [[nodiscard]] size_t compressChunk(gsl::span<BGRAPixel const> const pixels,
+                                       gsl::span<std::uint8_t> const     output) noexcept;
+
     /// @brief Flushes the buffer at the end of the image data.
     ///
     /// @return Either a final OpRun-Code or nothing.
@@ -34,6 +62,13 @@ public:
     [[nodiscard]] gsl::span<std::uint8_t const> flush() noexcept;
 
 private:
+    /// @brief Encodes a pixel that differs from the last pixel, writing a pending run first.
+    ///
+    /// @param pixel The pixel to encode.
+    /// @param output Pointer to the position to write the bytes to, needs to have room for 6 bytes.
+    /// @return Pointer to the position after the written bytes.
+    std::uint8_t *encode(BGRAPixel const &pixel, std::uint8_t *output) noexcept;
+
     /// @brief The last pixel saved.
     BGRAPixel _lastPixel{};
 
@@ -57,15 +92,19 @@ private:
 /// @brief Writes an image to a file using the Quite-Okay-Image format.
 ///
 /// @remarks https://qoiformat.org/qoi-specification.pdf
-class Writer : public IImageWriter<BGRAPixel>
+class Writer : public IImageWriter<BGRAPixel>, public IImageStreamWriter<BGRAPixel>
 {
 public:
     using IImageWriter::writeContentOf;
 
-    /// @brief Initializes a new BMPWriter.
+    /// @brief Initializes a new QOI::Writer.
     ///
     /// @param filepath The path to write the QOI-File to.
-    Writer(std::filesystem::path const filepath) noexcept;
+    /// @param threads The number of threads to compress the image with, 0 writes a plain QOI file.
+    /// @remarks Any number of threads greater 0 writes the chunk index extension, which still is a valid QOI file
+    ///          but can also be decompressed in parallel by the QOI::Reader. Images without pixels are always
+    ///          written as plain QOI-Files.
+    Writer(std::filesystem::path const filepath, std::uint32_t const threads = 0U) noexcept;
 
     /// @copydoc IImageWriter::init
     bool init() noexcept override;
@@ -76,9 +115,47 @@ public:
     /// @copydoc IImageWriter::deinit
     void deinit() noexcept override;
 
+    /// @copydoc IImageStreamWriter::begin
+    /// @remarks Streamed images are always written as plain QOI-Files, regardless of the number of threads.
+    bool begin(Rectangle const &dimensions) noexcept override;
+
+    /// @copydoc IImageStreamWriter::writeRows
+    bool writeRows(gsl::span<BGRAPixel const> const rows) noexcept override;
+
+    /// @copydoc IImageStreamWriter::end
+    bool end() noexcept override;
+
 private:
-    /// @brief The path to write the BMP-File to.
+    /// @brief Writes the image as a chunked QOI-File.
+    ///
+    /// @param stream The stream to write to, the header is already written.
+    /// @param dimensions The dimensions of the image.
+    /// @param buffer The buffer of image data to write.
+    /// @return True if writing was successful, false otherwise.
+    bool writeChunked(std::ofstream                   &stream,
+                      Rectangle const                 &dimensions,
+                      gsl::span<BGRAPixel const> const buffer) noexcept;
+
+    /// @brief The path to write the QOI-File to.
     std::filesystem::path const _filepath;
+
+    /// @brief The number of threads to compress the image with, 0 for a plain QOI-File.
+    std::uint32_t _threads{};
+
+    /// @brief The stream of the image being written row by row.
+    std::ofstream _stream{};
+
+    /// @brief The dimensions of the image being written row by row.
+    Rectangle _streamDimensions{};
+
+    /// @brief The number of rows written to the stream.
+    std::uint32_t _rowsWritten{};
+
+    /// @brief The compressor for the image being written row by row, keeping its state between the rows.
+    Internal::Compressor _compressor{};
+
+    /// @brief Buffer for the compressed rows.
+    std::vector<std::uint8_t> _compressed{};
 };
 
 } // namespace Terrahertz::QOI
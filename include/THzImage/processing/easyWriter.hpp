@@ -18,7 +18,8 @@ public:
     /// @brief Initializes a new EasyWriter instance.
     ///
     /// @param filepath The path for the files, has to contain a single '?' to signify where the numbering shall go.
-    EasyWriter(std::filesystem::path const filepath) noexcept;
+    /// @param options The options for compressing the PNG-files.
+    EasyWriter(std::filesystem::path const filepath, PNG::CompressionOptions const options = {}) noexcept;
 
     /// @brief Writes the given image to a PNG file.
     ///
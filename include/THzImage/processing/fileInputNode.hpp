@@ -6,6 +6,7 @@
 #include "THzImage/processing/iNode.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 
@@ -23,9 +24,13 @@ public:
     /// @param bufferSize The amount of images the node will store.
     /// @param path The path to the directory.
     /// @param mode The mode the node is operating in.
+    /// @param workers The number of threads decoding the images ahead of time, 0 to decode each image on next.
+    /// @param cache The cache for the decoded images, nullptr to always decode the images.
     FileInputNode(size_t const                 bufferSize,
                   std::filesystem::path const &path,
-                  Mode const                   mode = Mode::automatic) noexcept;
+                  Mode const                   mode    = Mode::automatic,
+                  std::uint32_t const          workers = 0U,
+                  ImageCache                  *cache   = nullptr) noexcept;
 
     /// @brief Explicitly deleted to prevent copy construction.
     FileInputNode(FileInputNode const &) noexcept = delete;
@@ -58,7 +63,10 @@ public:
     [[nodiscard]] ToCountResult toCount(size_t const target, bool const force = false) noexcept override;
 
     /// @copydoc INode::operator[]
-    [[nodiscard]] ImageType &operator[](size_t const index) noexcept override;
+    [[nodiscard]] ImageType const &operator[](size_t const index) noexcept override;
+
+    /// @copydoc INode::share
+    [[nodiscard]] SharedImage<BGRAPixel> share(size_t const index) noexcept override;
 
     /// @copydoc INode::slots
     [[nodiscard]] size_t slots() const noexcept override;
@@ -2,6 +2,7 @@
 #define THZ_IMAGE_PROCESSING_INODE_HPP
 
 #include "THzImage/common/image.hpp"
+#include "THzImage/common/sharedImage.hpp"
 
 namespace Terrahertz::ImageProcessing {
 
@@ -52,7 +53,21 @@ public:
     /// @param index The index of the image, 0 is the newest image.
     /// @return The image for the given index, empty if indes is out of range.
     /// @remark Returns an empty image if index is out of range.
-    [[nodiscard]] virtual ImageType &operator[](size_t const index) noexcept = 0;
+    [[nodiscard]] virtual ImageType const &operator[](size_t const index) noexcept = 0;
+
+    /// @brief Shares the images stored by the node.
+    ///
+    /// @param index The index of the image, 0 is the newest image.
+    /// @return The handle to the image for the given index, empty if index is out of range.
+    /// @remark Nodes backed by shared images return them without copying, the default falls back to a copy.
+    [[nodiscard]] virtual SharedImage<TPixelType> share(size_t const index) noexcept
+    {
+        if (index < slots())
+        {
+            return SharedImage<TPixelType>::copyOf((*this)[index]);
+        }
+        return {};
+    }
 
     /// @brief Returns the number of slots of the node.
     ///
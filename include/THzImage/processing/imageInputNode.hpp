@@ -40,7 +40,7 @@ public:
     [[nodiscard]] ToCountResult toCount(size_t const target, bool const force = false) noexcept override;
 
     /// @copydoc INode::operator[]
-    [[nodiscard]] ImageType &operator[](size_t const index) noexcept override;
+    [[nodiscard]] ImageType const &operator[](size_t const index) noexcept override;
 
     /// @copydoc INode::slots
     [[nodiscard]] size_t slots() const noexcept override;
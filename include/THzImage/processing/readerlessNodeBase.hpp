@@ -58,7 +58,7 @@ public:
     }
 
     /// @copydoc INode::operator[]
-    [[nodiscard]] MyImageType &operator[](size_t const index) noexcept override
+    [[nodiscard]] MyImageType const &operator[](size_t const index) noexcept override
     {
         if (index < _buffer.slots())
         {
@@ -67,6 +67,16 @@ public:
         return _emptyImage;
     }
 
+    /// @copydoc INode::share
+    [[nodiscard]] SharedImage<TPixelType> share(size_t const index) noexcept override
+    {
+        if (index < _buffer.slots())
+        {
+            return _buffer.share(index);
+        }
+        return {};
+    }
+
     /// @copydoc INode::slots
     [[nodiscard]] size_t slots() const noexcept override { return _buffer.slots(); }
 
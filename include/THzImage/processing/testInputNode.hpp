@@ -39,7 +39,10 @@ public:
     [[nodiscard]] ToCountResult toCount(size_t const target, bool const force = false) noexcept override;
 
     /// @copydoc INode::operator[]
-    [[nodiscard]] ImageType &operator[](size_t const index) noexcept override;
+    [[nodiscard]] ImageType const &operator[](size_t const index) noexcept override;
+
+    /// @copydoc INode::share
+    [[nodiscard]] SharedImage<BGRAPixel> share(size_t const index) noexcept override;
 
     /// @copydoc INode::slots
     [[nodiscard]] size_t slots() const noexcept override;
@@ -49,7 +52,7 @@ public:
 
 private:
     /// @brief The image to make available.
-    BGRAImage _image{};
+    SharedImage<BGRAPixel> _image{};
 
     /// @brief Counts how often next() has been called.
     size_t _counter{};
@@ -0,0 +1,108 @@
+#include "THzImage/common/indexedImage.hpp"
+
+#include "THzImage/io/gifWriter.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace Terrahertz {
+
+bool IndexedImage::setDimensions(Rectangle const &dim) noexcept
+{
+    auto const newArea = dim.area();
+    if (_indices.size() != newArea)
+    {
+        _indices.resize(newArea);
+        if (_indices.size() != newArea)
+        {
+            return false;
+        }
+    }
+    _dimensions = dim;
+    return true;
+}
+
+bool IndexedImage::setPalette(gsl::span<BGRAPixel const> const palette) noexcept
+{
+    if (palette.size() > MaxColors)
+    {
+        return false;
+    }
+    std::copy(palette.begin(), palette.end(), _palette.begin());
+    _colors = palette.size();
+    return true;
+}
+
+bool IndexedImage::operator==(IndexedImage const &other) const noexcept
+{
+    if (this == &other)
+    {
+        return true;
+    }
+    auto const ownPalette   = palette();
+    auto const otherPalette = other.palette();
+    return (_dimensions == other._dimensions) && (_indices == other._indices) &&
+           std::equal(ownPalette.begin(), ownPalette.end(), otherPalette.begin(), otherPalette.end());
+}
+
+bool IndexedImage::convertFrom(Image<BGRAPixel> const &image, bool const dither, bool const exact) noexcept
+{
+    auto const area = image.dimensions().area();
+    if ((area == 0U) || !setDimensions(image.dimensions()))
+    {
+        return false;
+    }
+    gsl::span<BGRAPixel const> const pixels{&image[0U], area};
+
+    // the color reduction is too large to be put on the stack
+    auto const reduction = std::make_unique<GIF::Internal::ColorReduction>(1U, exact);
+    reduction->analyze(pixels);
+    if (dither)
+    {
+        GIF::Internal::OrderedDithering dithering{};
+        dithering.setParameters(*reduction);
+        dithering.convert(_dimensions.width, pixels, _indices);
+    }
+    else
+    {
+        for (auto i = 0U; i < area; ++i)
+        {
+            _indices[i] = reduction->convert(pixels[i]);
+        }
+    }
+
+    auto const colorTable = reduction->colorTable();
+    (void)setPalette(colorTable);
+    auto const transparentIndex = static_cast<std::uint8_t>(_colors);
+    for (auto i = 0U; i < area; ++i)
+    {
+        if (pixels[i].alpha == 0U)
+        {
+            _indices[i] = transparentIndex;
+        }
+    }
+    if (std::find(_indices.cbegin(), _indices.cend(), transparentIndex) != _indices.cend())
+    {
+        _palette[_colors++] = BGRAPixel{0U, 0U, 0U, 0U};
+    }
+    return true;
+}
+
+bool IndexedImage::expandInto(Image<BGRAPixel> &image) const noexcept
+{
+    if (!image.setDimensions(_dimensions))
+    {
+        return false;
+    }
+    // unused entries of the lookup stay transparent black
+    std::array<BGRAPixel, MaxColors> lookup{};
+    std::fill(lookup.begin(), lookup.end(), BGRAPixel{0U, 0U, 0U, 0U});
+    std::copy(_palette.begin(), _palette.begin() + _colors, lookup.begin());
+    for (auto i = 0U; i < _indices.size(); ++i)
+    {
+        image[i] = lookup[_indices[i]];
+    }
+    return true;
+}
+
+} // namespace Terrahertz
@@ -1,12 +1,27 @@
 #include "THzImage/io/autoFileReader.hpp"
 
 #include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/byteorder.hpp"
+#include "THzCommon/utility/fstreamhelpers.hpp"
 #include "THzCommon/utility/stringhelpers.hpp"
+#include "THzImage/common/image.hpp"
 #include "THzImage/io/bmpReader.hpp"
+#include "THzImage/io/frameReader.hpp"
+#include "THzImage/io/gifReader.hpp"
 #include "THzImage/io/pngReader.hpp"
 #include "THzImage/io/qoiReader.hpp"
+#include "bmpCommons.hpp"
+#include "gifCommons.hpp"
+#include "parallelCommons.hpp"
+#include "qoiCommons.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
 
 namespace Terrahertz::AutoFile {
 
@@ -16,40 +31,334 @@ struct ReaderProject
     static constexpr char const *name() noexcept { return "THzImage.IO.AutoFile.Reader"; }
 };
 
-/// @brief Enumeration of all supported file formats.
-enum class FileFormat
-{
-    Unknown,
-    BMP,
-    PNG,
-    QOI
-};
+/// @brief The signature at the start of each PNG-file.
+constexpr std::array<std::uint8_t, 8U> PNGSignature{0x89U, 0x50U, 0x4EU, 0x47U, 0x0DU, 0x0AU, 0x1AU, 0x0AU};
+
+/// @brief The number of bytes needed to identify all supported formats.
+constexpr size_t SniffedBytes{PNGSignature.size()};
 
-/// @brief Returns the order in which to check formats of the given filepath.
+/// @brief Returns the format hinted by the extension of the given filepath.
 ///
-/// @param path The path of the file to return the order for.
-/// @return The order in which to check the files.
-static std::array<FileFormat, 4U> orderForFile(std::filesystem::path const &path) noexcept
+/// @param path The path of the file to return the format for.
+/// @return The format hinted by the extension.
+static FileFormat formatForExtension(std::filesystem::path const &path) noexcept
 {
     auto const extension = toLower(path.extension().string());
     if (extension == ".png")
     {
-        return {FileFormat::PNG, FileFormat::BMP, FileFormat::QOI, FileFormat::Unknown};
+        return FileFormat::PNG;
     }
     if (extension == ".bmp")
     {
-        return {FileFormat::BMP, FileFormat::PNG, FileFormat::QOI, FileFormat::Unknown};
+        return FileFormat::BMP;
     }
     if (extension == ".qoi")
     {
-        return {FileFormat::QOI, FileFormat::PNG, FileFormat::BMP, FileFormat::Unknown};
+        return FileFormat::QOI;
+    }
+    if (extension == ".gif")
+    {
+        return FileFormat::GIF;
+    }
+    if (extension == ".thzf")
+    {
+        return FileFormat::Frame;
+    }
+    return FileFormat::Unknown;
+}
+
+/// @brief Determines the format of the file opened by the given stream using the magic bytes at its start.
+///
+/// @param stream The stream to read the magic bytes from, positioned at the start of the file.
+/// @return The format of the file, FileFormat::Unknown if the file could not be read or has an unsupported format.
+/// @remarks The stream is positioned at the start of the file again afterwards.
+static FileFormat identifyFormat(std::ifstream &stream) noexcept
+{
+    std::array<std::uint8_t, SniffedBytes> bytes{};
+    auto const                             count = readFromStream(stream, gsl::span<std::uint8_t>{bytes});
+    stream.clear();
+    stream.seekg(0);
+
+    auto const startsWith = [&](gsl::span<std::uint8_t const> const magic) noexcept {
+        return (count >= magic.size()) && std::equal(magic.begin(), magic.end(), bytes.begin());
+    };
+    auto const asBytes = [](auto const &value) noexcept {
+        return gsl::span<std::uint8_t const>{std::bit_cast<std::uint8_t const *>(&value), sizeof(value)};
+    };
+    if (startsWith(PNGSignature))
+    {
+        return FileFormat::PNG;
+    }
+    if (startsWith(asBytes(BMP::FileHeader::MagicBytes)))
+    {
+        return FileFormat::BMP;
+    }
+    if (startsWith(asBytes(QOI::Header::MagicBytes)))
+    {
+        return FileFormat::QOI;
+    }
+    if (startsWith(asBytes(GIF::Header::Signature89a)) || startsWith(asBytes(GIF::Header::Signature87a)))
+    {
+        return FileFormat::GIF;
+    }
+    if (startsWith(asBytes(Frame::Header::MagicBytes)))
+    {
+        return FileFormat::Frame;
+    }
+    return FileFormat::Unknown;
+}
+
+/// @brief Determines the format of the given file using the magic bytes at its start.
+///
+/// @param path The path of the file to determine the format of.
+/// @return The format of the file, FileFormat::Unknown if the file could not be read or has an unsupported format.
+/// @remarks Only the first few bytes of the file are read, using a single open of the file.
+static FileFormat sniffFormat(std::filesystem::path const &path) noexcept
+{
+    std::ifstream stream{path, std::ios::binary};
+    if (!stream.is_open())
+    {
+        return FileFormat::Unknown;
+    }
+    return identifyFormat(stream);
+}
+
+/// @brief Reads the information stored in the IHDR chunk of a PNG-file.
+///
+/// @param stream The stream to read from, positioned at the start of the file.
+/// @param info The info to fill.
+/// @return True if the chunk could be read, false otherwise.
+static bool probePNG(std::ifstream &stream, ImageInfo &info) noexcept
+{
+    // the IHDR chunk always directly follows the signature
+    std::array<std::uint8_t, 26U> header{};
+    if (readFromStream(stream, gsl::span<std::uint8_t>{header}) != header.size())
+    {
+        return false;
+    }
+    auto const readUInt32 = [&](size_t const offset) noexcept {
+        std::uint32_t value{};
+        std::memcpy(&value, &header[offset], sizeof(value));
+        return flipByteOrder(value);
+    };
+    // the number of channels for each color type: gray, -, RGB, palette, gray + alpha, -, RGBA
+    constexpr std::array<std::uint8_t, 7U> Channels{1U, 0U, 3U, 1U, 2U, 0U, 4U};
+
+    auto const colorType = header[25U];
+    info.dimensions      = Rectangle{readUInt32(16U), readUInt32(20U)};
+    info.bitsPerPixel    = (colorType < Channels.size()) ? header[24U] * Channels[colorType] : 0U;
+    info.frameCount      = 1U;
+    return true;
+}
+
+/// @brief Reads the information stored in the header of a BMP-file.
+///
+/// @param stream The stream to read from, positioned at the start of the file.
+/// @param info The info to fill.
+/// @return True if the header could be read, false otherwise.
+static bool probeBMP(std::ifstream &stream, ImageInfo &info) noexcept
+{
+    BMP::Header header{};
+    if (!readFromStream(stream, header))
+    {
+        return false;
     }
-    return {FileFormat::Unknown, FileFormat::PNG, FileFormat::BMP, FileFormat::QOI};
+    // a negative height signals a top-down image
+    auto const width  = static_cast<std::uint32_t>(std::abs(header.infoHeader.width));
+    auto const height = static_cast<std::uint32_t>(std::abs(header.infoHeader.height));
+    info.dimensions   = Rectangle{width, height};
+    info.bitsPerPixel = header.infoHeader.bitCount;
+    info.frameCount   = 1U;
+    return true;
 }
 
-Reader::Reader(std::filesystem::path const path, ExtensionMode mode) noexcept
+/// @brief Reads the information stored in the header of a QOI-file.
+///
+/// @param stream The stream to read from, positioned at the start of the file.
+/// @param info The info to fill.
+/// @return True if the header could be read, false otherwise.
+static bool probeQOI(std::ifstream &stream, ImageInfo &info) noexcept
+{
+    QOI::Header header{};
+    if (!readFromStream(stream, header))
+    {
+        return false;
+    }
+    info.dimensions   = Rectangle{flipByteOrder(header.width), flipByteOrder(header.height)};
+    info.bitsPerPixel = header.channels * 8U;
+    info.frameCount   = 1U;
+    return true;
+}
+
+/// @brief Skips a sequence of data sub-blocks, including the block terminator.
+///
+/// @param stream The stream positioned at the size of the first sub-block.
+/// @return True if the terminator was reached, false if the file ended before.
+static bool skipSubBlocks(std::ifstream &stream) noexcept
+{
+    std::uint8_t size{};
+    while (readFromStream(stream, size))
+    {
+        if (size == 0U)
+        {
+            return true;
+        }
+        stream.seekg(size, std::ios::cur);
+    }
+    return false;
+}
+
+/// @brief Reads the information stored in the header of a GIF-file and counts the frames of the file.
+///
+/// @param stream The stream to read from, positioned at the start of the file.
+/// @param info The info to fill.
+/// @return True if the header could be read, false otherwise.
+/// @remarks The data of the frames is skipped without being decoded.
+static bool probeGIF(std::ifstream &stream, ImageInfo &info) noexcept
+{
+    GIF::Header header{};
+    if (!readFromStream(stream, header))
+    {
+        return false;
+    }
+    auto const tableSize = [](std::uint8_t const packedFields) noexcept { return 3 << ((packedFields & 0x07U) + 1U); };
+    if ((header.packedFields & GIF::Header::GlobalColorTableFlag) != 0U)
+    {
+        stream.seekg(tableSize(header.packedFields), std::ios::cur);
+    }
+    info.dimensions   = Rectangle{header.width, header.height};
+    info.bitsPerPixel = (header.packedFields & 0x07U) + 1U;
+    info.frameCount   = 0U;
+
+    // a truncated file still reports the frames found so far, like the reader does
+    std::uint8_t introducer{};
+    while (readFromStream(stream, introducer))
+    {
+        if (introducer == GIF::ImageSeparator)
+        {
+            GIF::ImageDescriptor descriptor{};
+            // the separator is already read
+            if (readFromStream(stream, gsl::span<std::uint8_t>{&descriptor.separator + 1U, sizeof(descriptor) - 1U}) !=
+                (sizeof(descriptor) - 1U))
+            {
+                break;
+            }
+            if ((descriptor.packedFields & GIF::ImageDescriptor::LocalColorTableFlag) != 0U)
+            {
+                stream.seekg(tableSize(descriptor.packedFields), std::ios::cur);
+            }
+            // skip the minimum code size
+            stream.seekg(1, std::ios::cur);
+            if (!skipSubBlocks(stream))
+            {
+                break;
+            }
+            ++info.frameCount;
+        }
+        else if (introducer == GIF::ExtensionIntroducer)
+        {
+            // skip the label
+            stream.seekg(1, std::ios::cur);
+            if (!skipSubBlocks(stream))
+            {
+                break;
+            }
+        }
+        else
+        {
+            // either the trailer or data not following the format
+            break;
+        }
+    }
+    return true;
+}
+
+/// @brief Reads the information stored in the header of a frame file.
+///
+/// @param stream The stream to read from, positioned at the start of the file.
+/// @param info The info to fill.
+/// @return True if the header could be read, false otherwise.
+static bool probeFrame(std::ifstream &stream, ImageInfo &info) noexcept
+{
+    Frame::Header header{};
+    if (!readFromStream(stream, header))
+    {
+        return false;
+    }
+    info.dimensions   = Rectangle{header.width, header.height};
+    info.bitsPerPixel = header.pixelSize * 8U;
+    info.frameCount   = 1U;
+    return true;
+}
+
+std::optional<ImageInfo> probe(std::filesystem::path const &path) noexcept
+{
+    std::ifstream stream{path, std::ios::binary};
+    if (!stream.is_open())
+    {
+        return {};
+    }
+    ImageInfo info{};
+    info.format = identifyFormat(stream);
+
+    auto success = false;
+    switch (info.format)
+    {
+    case FileFormat::BMP:
+        success = probeBMP(stream, info);
+        break;
+    case FileFormat::Frame:
+        success = probeFrame(stream, info);
+        break;
+    case FileFormat::GIF:
+        success = probeGIF(stream, info);
+        break;
+    case FileFormat::PNG:
+        success = probePNG(stream, info);
+        break;
+    case FileFormat::QOI:
+        success = probeQOI(stream, info);
+        break;
+    default: // FileFormat::Unknown
+        break;
+    }
+    if (!success || (info.dimensions.area() == 0U))
+    {
+        return {};
+    }
+    return info;
+}
+
+std::vector<ProbedFile> probeDirectory(std::filesystem::path const &directorypath, std::uint32_t const threads) noexcept
+{
+    std::vector<ProbedFile> files{};
+    std::error_code         error{};
+    for (std::filesystem::recursive_directory_iterator iterator{directorypath, error}, end{}; iterator != end;
+         iterator.increment(error))
+    {
+        if (iterator->is_regular_file(error))
+        {
+            files.emplace_back(ProbedFile{iterator->path(), {}});
+        }
+    }
+
+    runParallel(files.size(), std::max(threads, 1U), [&](size_t const index) noexcept {
+        if (auto const info = probe(files[index].path))
+        {
+            files[index].info = *info;
+        }
+    });
+    // files which could not be probed keep FileFormat::Unknown
+    std::erase_if(files, [](ProbedFile const &file) noexcept { return file.info.format == FileFormat::Unknown; });
+    return files;
+}
+
+Reader::Reader(std::filesystem::path const path, ExtensionMode mode, ImageCache *cache) noexcept : _cache{cache}
 {
     static_assert(InnerReaderBufferSize >= sizeof(BMP::Reader), "_innerReaderBuffer too small for BMP::Reader.");
+    static_assert(InnerReaderBufferSize >= sizeof(Frame::Reader<BGRAPixel>),
+                  "_innerReaderBuffer too small for Frame::Reader.");
+    static_assert(InnerReaderBufferSize >= sizeof(GIF::Reader), "_innerReaderBuffer too small for GIF::Reader.");
     static_assert(InnerReaderBufferSize >= sizeof(PNG::Reader), "_innerReaderBuffer too small for PNG::Reader.");
     static_assert(InnerReaderBufferSize >= sizeof(QOI::Reader), "_innerReaderBuffer too small for QOI::Reader.");
     reset(path, mode);
@@ -64,7 +373,9 @@ void Reader::reset(std::filesystem::path const path, ExtensionMode mode) noexcep
     _mode = mode;
 }
 
-bool Reader::extensionSupported() const noexcept { return orderForFile(_path)[0U] != FileFormat::Unknown; }
+void Reader::setCache(ImageCache *cache) noexcept { _cache = cache; }
+
+bool Reader::extensionSupported() const noexcept { return formatForExtension(_path) != FileFormat::Unknown; }
 
 bool Reader::imagePresent() const noexcept { return _path != std::filesystem::path{}; }
 
@@ -80,44 +391,70 @@ bool Reader::init() noexcept
         return false;
     }
 
-    for (auto const format : orderForFile(_path))
+    // the magic bytes decide which reader to use, so only a single reader opens the file
+    auto format = FileFormat::Unknown;
+    if (_mode == ExtensionMode::strict)
     {
-        switch (format)
+        format = sniffFormat(_path);
+        if (format != formatForExtension(_path))
         {
-        case FileFormat::BMP:
-            _innerReader = new (_innerReaderBuffer.data()) BMP::Reader(_path);
-            break;
-        case FileFormat::PNG:
-            _innerReader = new (_innerReaderBuffer.data()) PNG::Reader(_path);
-            break;
-        case FileFormat::QOI:
-            _innerReader = new (_innerReaderBuffer.data()) QOI::Reader(_path);
-            break;
-        default: // FileFormat::Unknown
-            break;
+            logMessage<LogLevel::Trace, ReaderProject>("File content does not match the extension");
+            deinit();
+            return false;
         }
-        if (_innerReader != nullptr)
+    }
+    if (_cache != nullptr)
+    {
+        // taken before the file is opened, so a change while decoding can't be cached as the current version
+        _cacheKey = ImageCache::keyOf(_path);
+        if (_cacheKey)
         {
-            if (_innerReader->init())
+            _cached = _cache->find(*_cacheKey);
+            if (_cached)
             {
                 return true;
             }
-            else
-            {
-                deinitInnerReader();
-            }
-        }
-        if (_mode == ExtensionMode::strict)
-        {
-            break;
         }
     }
+    if (_mode == ExtensionMode::lenient)
+    {
+        format = sniffFormat(_path);
+    }
+    switch (format)
+    {
+    case FileFormat::BMP:
+        _innerReader = new (_innerReaderBuffer.data()) BMP::Reader(_path);
+        break;
+    case FileFormat::Frame:
+        _innerReader = new (_innerReaderBuffer.data()) Frame::Reader<BGRAPixel>(_path);
+        break;
+    case FileFormat::GIF:
+        _innerReader = new (_innerReaderBuffer.data()) GIF::Reader(_path);
+        break;
+    case FileFormat::PNG:
+        _innerReader = new (_innerReaderBuffer.data()) PNG::Reader(_path);
+        break;
+    case FileFormat::QOI:
+        _innerReader = new (_innerReaderBuffer.data()) QOI::Reader(_path);
+        break;
+    default: // FileFormat::Unknown
+        logMessage<LogLevel::Trace, ReaderProject>("File format could not be determined");
+        break;
+    }
+    if ((_innerReader != nullptr) && _innerReader->init())
+    {
+        return true;
+    }
     deinit();
     return false;
 }
 
 Rectangle Reader::dimensions() const noexcept
 {
+    if (_cached)
+    {
+        return _cached->dimensions();
+    }
     if (_innerReader != nullptr)
     {
         return _innerReader->dimensions();
@@ -127,16 +464,43 @@ Rectangle Reader::dimensions() const noexcept
 
 bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
 {
-    if (_innerReader != nullptr)
+    if (_cached)
     {
-        return _innerReader->read(buffer);
+        auto const pixels = _cached->dimensions().area();
+        if (buffer.size() < pixels)
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Given buffer is too small for the data");
+            return false;
+        }
+        std::copy_n(&(*_cached)[0U], pixels, buffer.begin());
+        return true;
     }
-    return false;
+    if (_innerReader == nullptr)
+    {
+        return false;
+    }
+    if (!_innerReader->read(buffer))
+    {
+        return false;
+    }
+    if ((_cache != nullptr) && _cacheKey)
+    {
+        auto const dimensions = _innerReader->dimensions();
+        auto       image      = std::make_shared<Image<BGRAPixel>>();
+        if (image->setDimensions(dimensions))
+        {
+            std::copy_n(buffer.begin(), dimensions.area(), &(*image)[0U]);
+            _cache->insert(*_cacheKey, SharedImage<BGRAPixel>{std::move(image)});
+        }
+    }
+    return true;
 }
 
 void Reader::deinit() noexcept
 {
     deinitInnerReader();
+    _cached.reset();
+    _cacheKey.reset();
     // reset path to not load the same file twice
     _path = std::filesystem::path{};
 }
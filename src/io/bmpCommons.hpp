@@ -3,6 +3,7 @@
 
 #include "THzImage/common/pixel.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <gsl/gsl>
 #include <optional>
@@ -103,6 +104,92 @@ static_assert(sizeof(Header) == 54U, "Header has the wrong size.");
 
 #pragma pack()
 
+/// @brief Checks if the given header describes an image supported by the readers.
+///
+/// @param header The header to check, a negative height is turned positive.
+/// @param bottomUp Output: True if the lines are stored bottom-up, false if top-down.
+/// @return A description of the problem, nullptr if the header is supported.
+/// @remarks The magic bytes have to be checked beforehand.
+inline char const *checkHeader(Header &header, bool &bottomUp) noexcept
+{
+    if ((header.infoHeader.bitCount != 24U) && (header.infoHeader.bitCount != 32U))
+    {
+        return "Unsupported bitCount";
+    }
+    if (header.infoHeader.compression != 0U)
+    {
+        return "Unsupported compression";
+    }
+    if (header.infoHeader.width == 0)
+    {
+        return "Width is zero";
+    }
+    if (header.infoHeader.height == 0)
+    {
+        return "Height is zero";
+    }
+    if (header.fileHeader.offBits != 54U)
+    {
+        return "Unsupported number of offBits";
+    }
+    bottomUp = true;
+    if (header.infoHeader.height < 0)
+    {
+        header.infoHeader.height = -header.infoHeader.height;
+        bottomUp                 = false;
+    }
+    Header sanityCheck{header.infoHeader.width, header.infoHeader.height, header.infoHeader.bitCount};
+    if (header.infoHeader.sizeImage != sanityCheck.infoHeader.sizeImage)
+    {
+        return "Size of the image data does not match dimensions and bitcount";
+    }
+    return nullptr;
+}
+
+/// @brief Calculates the number of bytes of a line in the file, including the padding.
+///
+/// @param width The width of the image [pxl].
+/// @param bitCount The bit count of the image [bit].
+/// @return The number of bytes of a line.
+constexpr size_t lineLength(size_t const width, size_t const bitCount) noexcept
+{
+    // (x & ~3) equals (x / 4 * 4), needed for padding
+    return ((bitCount / 8U) * width + 3U) & ~size_t{3U};
+}
+
+/// @brief Expands a line of 24 bit pixels to BGRAPixels, setting alpha to opaque.
+///
+/// @param line The bytes of the line, 3 per pixel.
+/// @param output The pixels of the line.
+/// @remarks Kept as a plain loop with fixed steps so the compiler is able to vectorize it.
+inline void expandLine(std::uint8_t const *line, gsl::span<BGRAPixel> const output) noexcept
+{
+    for (auto &pixel : output)
+    {
+        pixel.blue  = line[0U];
+        pixel.green = line[1U];
+        pixel.red   = line[2U];
+        pixel.alpha = 0xFFU;
+        line += 3U;
+    }
+}
+
+/// @brief Packs a line of BGRAPixels to 24 bit pixels, dropping alpha.
+///
+/// @param line The pixels of the line.
+/// @param output The bytes of the line, needs room for 3 bytes per pixel.
+/// @remarks Kept as a plain loop with fixed steps so the compiler is able to vectorize it.
+inline void packLine(gsl::span<BGRAPixel const> const line, std::uint8_t *output) noexcept
+{
+    for (auto const &pixel : line)
+    {
+        output[0U] = pixel.blue;
+        output[1U] = pixel.green;
+        output[2U] = pixel.red;
+        output += 3U;
+    }
+}
+
 } // namespace Terrahertz::BMP
 
 #endif // !THZ_IMAGE_IO_BMPCOMMONS_HPP
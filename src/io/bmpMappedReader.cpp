@@ -0,0 +1,152 @@
+#include "THzImage/io/bmpMappedReader.hpp"
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/lineSequencer.hpp"
+#include "bmpCommons.hpp"
+
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace Terrahertz::BMP {
+
+/// @brief Name provider for the THzImage.IO.BMP.MappedReader class.
+struct MappedReaderProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.BMP.MappedReader"; }
+};
+
+MappedReader::MappedReader(std::filesystem::path const filepath) noexcept
+{
+    Logger::globalInstance().addProject<MappedReaderProject>();
+    _file.open(filepath);
+}
+
+MappedReader::~MappedReader() noexcept { deinit(); }
+
+bool MappedReader::fileTypeFits() noexcept
+{
+    auto const data = _file.data();
+    if (data.size() < sizeof(Header))
+    {
+        return false;
+    }
+    Header header{};
+    std::memcpy(&header, data.data(), sizeof(Header));
+    return header.fileHeader.magic == FileHeader::MagicBytes;
+}
+
+bool MappedReader::imagePresent() const noexcept
+{
+    // file is mapped at construction and will be unmapped on deinit
+    // creating the desired outputs
+    return _file.isOpen();
+}
+
+bool MappedReader::init() noexcept
+{
+    if (!_file.isOpen())
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>("File could not be mapped");
+        return false;
+    }
+    auto const data = _file.data();
+    if (data.size() < sizeof(Header))
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>("File too small for header structure");
+        return false;
+    }
+    Header header{};
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if (header.fileHeader.magic != FileHeader::MagicBytes)
+    {
+        // This has trace log level as we might try the reader on not BMP file to check the format
+        logMessage<LogLevel::Trace, MappedReaderProject>("Given file is not a BMP file");
+        return false;
+    }
+    if (auto const problem = checkHeader(header, _bottomUp))
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>(problem);
+        return false;
+    }
+    if ((data.size() - sizeof(Header)) < header.infoHeader.sizeImage)
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>("File too small for the image data");
+        return false;
+    }
+    _pixelData         = data.subspan(sizeof(Header), header.infoHeader.sizeImage);
+    _bitCount          = static_cast<std::uint8_t>(header.infoHeader.bitCount);
+    _dimensions.width  = header.infoHeader.width;
+    _dimensions.height = header.infoHeader.height;
+    return true;
+}
+
+Rectangle MappedReader::dimensions() const noexcept { return _dimensions; }
+
+bool MappedReader::read(gsl::span<BGRAPixel> buffer) noexcept
+{
+    if (_pixelData.empty())
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>("Reader was not initialized");
+        return false;
+    }
+    if (buffer.size() < _dimensions.area())
+    {
+        logMessage<LogLevel::Error, MappedReaderProject>("Given buffer is too small for the data");
+        return false;
+    }
+    auto const pixels = buffer.subspan(0U, _dimensions.area());
+    if (zeroCopy())
+    {
+        std::memcpy(pixels.data(), _pixelData.data(), pixels.size_bytes());
+        return true;
+    }
+    auto const  length    = lineLength(_dimensions.width, _bitCount);
+    auto        sequencer = LineSequencer<BGRAPixel>::create(pixels, _dimensions.width, _bottomUp);
+    auto const *lineData  = _pixelData.data();
+    for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine(), lineData += length)
+    {
+        if (_bitCount == 32U)
+        {
+            std::memcpy(line.data(), lineData, line.size_bytes());
+        }
+        else
+        {
+            expandLine(lineData, line);
+        }
+    }
+    return true;
+}
+
+void MappedReader::deinit() noexcept
+{
+    _pixelData = {};
+    _copy      = BGRAImage{};
+    _file.close();
+}
+
+bool MappedReader::zeroCopy() const noexcept { return (_bitCount == 32U) && !_bottomUp; }
+
+ImageView<BGRAPixel const> MappedReader::view() noexcept
+{
+    if (_pixelData.empty())
+    {
+        return {};
+    }
+    if (zeroCopy())
+    {
+        return ImageView<BGRAPixel const>{std::bit_cast<BGRAPixel const *>(_pixelData.data()), _dimensions};
+    }
+    if (_copy.dimensions() != _dimensions)
+    {
+        if (!_copy.setDimensions(_dimensions) || !read(gsl::span<BGRAPixel>{&_copy[0U], _dimensions.area()}))
+        {
+            logMessage<LogLevel::Error, MappedReaderProject>("Copying the image failed");
+            _copy = BGRAImage{};
+            return {};
+        }
+    }
+    return std::as_const(_copy).view();
+}
+
+} // namespace Terrahertz::BMP
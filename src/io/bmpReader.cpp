@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cstring>
+#include <vector>
 
 namespace Terrahertz::BMP {
 
@@ -70,46 +71,9 @@ bool Reader::init() noexcept
         logMessage<LogLevel::Trace, ReaderProject>("Given file is not a BMP file");
         return false;
     }
-    if ((header.infoHeader.bitCount != 24U) && (header.infoHeader.bitCount != 32U))
+    if (auto const problem = checkHeader(header, _bottomUp))
     {
-        logMessage<LogLevel::Error, ReaderProject>("Unsupported bitCount");
-        return false;
-    }
-    if (header.infoHeader.compression != 0U)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Unsupported compression");
-        return false;
-    }
-    if (header.infoHeader.width == 0)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Width is zero");
-        return false;
-    }
-    if (header.infoHeader.height == 0)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Height is zero");
-        return false;
-    }
-    if (header.infoHeader.compression != 0U)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Unsupported compression");
-        return false;
-    }
-    if (header.fileHeader.offBits != 54U)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Unsupported number of offBits");
-        return false;
-    }
-    _bottomUp = true;
-    if (header.infoHeader.height < 0)
-    {
-        header.infoHeader.height = -header.infoHeader.height;
-        _bottomUp                = false;
-    }
-    Header sanityCheck{header.infoHeader.width, header.infoHeader.height, header.infoHeader.bitCount};
-    if (header.infoHeader.sizeImage != sanityCheck.infoHeader.sizeImage)
-    {
-        logMessage<LogLevel::Error, ReaderProject>("Size of the image data does not match dimensions and bitcount");
+        logMessage<LogLevel::Error, ReaderProject>(problem);
         return false;
     }
     _bitCount          = static_cast<std::uint8_t>(header.infoHeader.bitCount);
@@ -127,7 +91,13 @@ bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
         logMessage<LogLevel::Error, ReaderProject>("Given buffer is too small for the data");
         return false;
     }
-    auto sequencer = LineSequencer<BGRAPixel>::create(buffer, _dimensions.width, _bottomUp);
+    auto const pixels = buffer.subspan(0U, _dimensions.area());
+    if ((_bitCount == 32U) && !_bottomUp)
+    {
+        // top-down 32 bit files store the image exactly like the buffer does
+        return readFromStream(_stream, pixels) == pixels.size();
+    }
+    auto sequencer = LineSequencer<BGRAPixel>::create(pixels, _dimensions.width, _bottomUp);
     if (_bitCount == 32U)
     {
         for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine())
@@ -140,27 +110,15 @@ bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
     }
     else
     {
-        auto const bytesUsed  = (_bitCount / 8U) * _dimensions.width;
-        auto const lineLength = (bytesUsed + 3U) & ~3U;
-        auto const padding    = lineLength - bytesUsed;
-
-        std::array<char, 3U> paddingBytes{};
-
+        // read each line including its padding at once and expand it afterwards
+        std::vector<std::uint8_t> lineBuffer(lineLength(_dimensions.width, _bitCount));
         for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine())
         {
-            for (auto const &pixel : line)
-            {
-                _stream.read(std::bit_cast<char *>(&pixel), 3U);
-                if (!_stream.good())
-                {
-                    return false;
-                }
-            }
-            _stream.read(paddingBytes.data(), padding);
-            if (!_stream.good())
+            if (readFromStream(_stream, gsl::span<std::uint8_t>{lineBuffer}) != lineBuffer.size())
             {
                 return false;
             }
+            expandLine(lineBuffer.data(), line);
         }
     }
     return true;
@@ -5,6 +5,8 @@
 #include "THzCommon/utility/lineSequencer.hpp"
 #include "bmpCommons.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 
@@ -42,34 +44,93 @@ bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const
     Header header{static_cast<std::int32_t>(dimensions.width), static_cast<std::int32_t>(dimensions.height), _bitCount};
     writeToStream(stream, header);
     auto sequencer = LineSequencer<BGRAPixel const>::create(buffer, dimensions.width);
-    if (_bitCount == 32U)
+    for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine())
     {
-        for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine())
-        {
-            writeToStream(stream, line);
-        }
+        writeLine(stream, line);
+    }
+
+    return true;
+}
+
+void Writer::deinit() noexcept {}
+
+bool Writer::begin(Rectangle const &dimensions) noexcept
+{
+    if (_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("An image is already being written");
+        return false;
+    }
+    if (dimensions.area() == 0U)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image dimensions are empty");
+        return false;
     }
-    else
+    _stream.open(_filepath, std::ios::binary);
+    if (!_stream.is_open())
     {
-        auto const bytesUsed  = (header.infoHeader.bitCount / 8U) * header.infoHeader.width;
-        auto const lineLength = (bytesUsed + 3U) & ~3U;
-        auto const padding    = lineLength - bytesUsed;
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
+        return false;
+    }
+    _streamDimensions = dimensions;
+    _rowsWritten      = 0U;
 
-        std::array<char, 3U> const paddingBytes{};
+    // a negative height marks the image as top-down
+    Header header{static_cast<std::int32_t>(dimensions.width), static_cast<std::int32_t>(dimensions.height), _bitCount};
+    header.infoHeader.height = -header.infoHeader.height;
+    return writeToStream(_stream, header);
+}
 
-        for (auto line = sequencer->nextLine(); !line.empty(); line = sequencer->nextLine())
+bool Writer::writeRows(gsl::span<BGRAPixel const> const rows) noexcept
+{
+    if (!_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("No image is being written");
+        return false;
+    }
+    auto const width = _streamDimensions.width;
+    auto const count = rows.size() / width;
+    if (((rows.size() % width) != 0U) || (count > (_streamDimensions.height - _rowsWritten)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Rows do not fit the image");
+        return false;
+    }
+    for (size_t row = 0U; row < count; ++row)
+    {
+        if (!writeLine(_stream, rows.subspan(row * width, width)))
         {
-            for (auto const &pixel : line)
-            {
-                stream.write(std::bit_cast<char const *>(&pixel), 3U);
-            }
-            stream.write(paddingBytes.data(), padding);
+            return false;
         }
     }
-
+    _rowsWritten += static_cast<std::uint32_t>(count);
     return true;
 }
 
-void Writer::deinit() noexcept {}
+bool Writer::end() noexcept
+{
+    if (!_stream.is_open())
+    {
+        return false;
+    }
+    auto const success = (_rowsWritten == _streamDimensions.height) && _stream.good();
+    if (!success)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image was not written completely");
+    }
+    _stream.close();
+    return success;
+}
+
+bool Writer::writeLine(std::ofstream &stream, gsl::span<BGRAPixel const> const line) noexcept
+{
+    if (_bitCount == 32U)
+    {
+        return writeToStream(stream, line);
+    }
+    _lineBuffer.resize(lineLength(line.size(), _bitCount));
+    packLine(line, _lineBuffer.data());
+    std::fill(_lineBuffer.begin() + static_cast<std::ptrdiff_t>(3U * line.size()), _lineBuffer.end(), 0U);
+    return writeToStream(stream, gsl::span<std::uint8_t const>{_lineBuffer});
+}
 
 } // namespace Terrahertz::BMP
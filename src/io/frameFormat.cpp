@@ -0,0 +1,94 @@
+#include "THzImage/io/frameFormat.hpp"
+
+#include "THzCommon/logging/logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <zlib.h>
+
+namespace Terrahertz::Frame {
+
+/// @brief Name provider for the THzImage.IO.Frame.Format class.
+struct FormatProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.Frame.Format"; }
+};
+
+std::uint32_t checksum(gsl::span<std::uint8_t const> const data) noexcept
+{
+    // crc32 takes the length as uInt, so huge images are processed in parts
+    constexpr size_t MaxPart{1U << 30U};
+
+    auto crc  = crc32(0UL, nullptr, 0U);
+    auto rest = data;
+    while (!rest.empty())
+    {
+        auto const part = std::min(rest.size(), MaxPart);
+        crc             = crc32(crc, rest.data(), static_cast<uInt>(part));
+        rest            = rest.subspan(part);
+    }
+    return static_cast<std::uint32_t>(crc);
+}
+
+char const *checkHeader(Header const &header, size_t const fileSize) noexcept
+{
+    if (header.version != Header::CurrentVersion)
+    {
+        return "Unsupported version of the frame format";
+    }
+    auto const pixelSize = pixelSizeOf(header.pixelTag);
+    if ((pixelSize == 0U) || (pixelSize != header.pixelSize))
+    {
+        return "Unsupported pixel type";
+    }
+    if ((header.width == 0U) || (header.height == 0U))
+    {
+        return "Image has an area of 0";
+    }
+    if ((header.dataOffset < sizeof(Header)) || ((header.dataOffset % Header::DataAlignment) != 0U))
+    {
+        return "Pixel data is not aligned";
+    }
+    if (header.dataSize != (static_cast<std::uint64_t>(header.width) * header.height * pixelSize))
+    {
+        return "Dimensions do not match the amount of data";
+    }
+    if ((fileSize < header.dataOffset) || ((fileSize - header.dataOffset) < header.dataSize))
+    {
+        return "File too small for the image data";
+    }
+    return nullptr;
+}
+
+bool writeFile(std::filesystem::path const &filepath,
+               Header const                &header,
+               gsl::span<std::uint8_t const> const data) noexcept
+{
+    Logger::globalInstance().addProject<FormatProject>();
+
+    std::array<std::uint8_t, Header::DataAlignment> prefix{};
+    std::memcpy(prefix.data(), &header, sizeof(Header));
+
+    std::ofstream stream{filepath, std::ios::binary | std::ios::trunc};
+    if (!stream.is_open())
+    {
+        logMessage<LogLevel::Error, FormatProject>("File could not be opened");
+        return false;
+    }
+    // the prefix stays in the buffer of the stream and is handed to the operating system together with the data,
+    // so the pixel data is written in one go without being copied
+    stream.write(std::bit_cast<char const *>(prefix.data()), prefix.size());
+    stream.write(std::bit_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+    stream.close();
+    if (!stream.good())
+    {
+        logMessage<LogLevel::Error, FormatProject>("Writing the file failed");
+        return false;
+    }
+    return true;
+}
+
+} // namespace Terrahertz::Frame
@@ -0,0 +1,174 @@
+#ifndef THZ_IMAGE_IO_GIFCOMMONS_HPP
+#define THZ_IMAGE_IO_GIFCOMMONS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Terrahertz::GIF {
+
+/// @brief Marks the start of an extension block.
+constexpr std::uint8_t ExtensionIntroducer{0x21U};
+
+/// @brief Label of the application extension.
+constexpr std::uint8_t ApplicationLabel{0xFFU};
+
+/// @brief Label of the graphic control extension.
+constexpr std::uint8_t GraphicControlLabel{0xF9U};
+
+/// @brief Marks the start of an image descriptor.
+constexpr std::uint8_t ImageSeparator{0x2CU};
+
+/// @brief Marks the end of the file.
+constexpr std::uint8_t Trailer{0x3BU};
+
+#pragma pack(1) // otherwise the structs would turn out too large
+/// @brief The header of the GIF file format, including the logical screen descriptor.
+struct Header
+{
+    /// @brief The signature and version written by the writer.
+    static constexpr std::array<char, 6U> Signature89a{'G', 'I', 'F', '8', '9', 'a'};
+
+    /// @brief The signature and version of files following the previous version of the format.
+    static constexpr std::array<char, 6U> Signature87a{'G', 'I', 'F', '8', '7', 'a'};
+
+    /// @brief Flag signalling that the global color table follows the header.
+    static constexpr std::uint8_t GlobalColorTableFlag{0x80U};
+
+    /// @brief The signature and version of the file.
+    std::array<char, 6U> signature{Signature89a};
+
+    /// @brief The width of the logical screen [pxl].
+    std::uint16_t width{};
+
+    /// @brief The height of the logical screen [pxl].
+    std::uint16_t height{};
+
+    /// @brief Global color table flag, color resolution, sort flag and size of the global color table.
+    std::uint8_t packedFields{};
+
+    /// @brief The index of the background color in the global color table.
+    std::uint8_t backgroundColorIndex{};
+
+    /// @brief The pixel aspect ratio, 0 if not given.
+    std::uint8_t pixelAspectRatio{};
+};
+static_assert(sizeof(Header) == 13U, "Header too large");
+
+/// @brief The graphic control extension controlling the transparency and timing of the following image.
+struct GraphicControlExtension
+{
+    /// @brief Flag signalling that the transparentColorIndex is used.
+    static constexpr std::uint8_t TransparencyFlag{0x01U};
+
+    /// @brief Disposal method leaving the image in place, so the next image is drawn on top of it.
+    static constexpr std::uint8_t DoNotDispose{0x04U};
+
+    /// @brief Mask for the disposal method in the packed fields.
+    static constexpr std::uint8_t DisposalMask{0x1CU};
+
+    /// @brief Disposal method clearing the region of the image to the background after displaying it.
+    static constexpr std::uint8_t RestoreBackground{0x08U};
+
+    /// @brief Disposal method restoring the region of the image to what was shown before the image.
+    static constexpr std::uint8_t RestorePrevious{0x0CU};
+
+    /// @brief Marks the start of the extension.
+    std::uint8_t introducer{ExtensionIntroducer};
+
+    /// @brief Identifies the graphic control extension.
+    std::uint8_t label{GraphicControlLabel};
+
+    /// @brief The size of the following fields [byte].
+    std::uint8_t blockSize{4U};
+
+    /// @brief Disposal method, user input flag and transparency flag.
+    std::uint8_t packedFields{};
+
+    /// @brief The time to wait before displaying the next image [1/100 s].
+    std::uint16_t delayTime{};
+
+    /// @brief The index of the transparent color.
+    std::uint8_t transparentColorIndex{};
+
+    /// @brief Terminates the extension.
+    std::uint8_t terminator{};
+};
+static_assert(sizeof(GraphicControlExtension) == 8U, "GraphicControlExtension too large");
+
+/// @brief The application extension defined by Netscape, setting the number of times an animation is played.
+struct LoopExtension
+{
+    /// @brief Marks the start of the extension.
+    std::uint8_t introducer{ExtensionIntroducer};
+
+    /// @brief Identifies an application extension.
+    std::uint8_t label{ApplicationLabel};
+
+    /// @brief The size of the application identifier [byte].
+    std::uint8_t blockSize{11U};
+
+    /// @brief The application identifier and authentication code.
+    std::array<char, 11U> identifier{'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0'};
+
+    /// @brief The size of the data sub-block [byte].
+    std::uint8_t subBlockSize{3U};
+
+    /// @brief Identifies the loop sub-block.
+    std::uint8_t subBlockId{1U};
+
+    /// @brief The number of times the animation is played, 0 meaning forever.
+    std::uint16_t loops{};
+
+    /// @brief Terminates the extension.
+    std::uint8_t terminator{};
+};
+static_assert(sizeof(LoopExtension) == 19U, "LoopExtension too large");
+
+/// @brief The descriptor preceding the data of each image.
+struct ImageDescriptor
+{
+    /// @brief Flag signalling that the local color table follows the descriptor.
+    static constexpr std::uint8_t LocalColorTableFlag{0x80U};
+
+    /// @brief Flag signalling that the image is stored interlaced.
+    static constexpr std::uint8_t InterlaceFlag{0x40U};
+
+    /// @brief Marks the start of the descriptor.
+    std::uint8_t separator{ImageSeparator};
+
+    /// @brief The column of the left edge of the image on the logical screen [pxl].
+    std::uint16_t left{};
+
+    /// @brief The row of the top edge of the image on the logical screen [pxl].
+    std::uint16_t top{};
+
+    /// @brief The width of the image [pxl].
+    std::uint16_t width{};
+
+    /// @brief The height of the image [pxl].
+    std::uint16_t height{};
+
+    /// @brief Local color table flag, interlace flag, sort flag and size of the local color table.
+    std::uint8_t packedFields{};
+};
+static_assert(sizeof(ImageDescriptor) == 10U, "ImageDescriptor too large");
+#pragma pack()
+
+/// @brief Returns the number of bits needed to address the given number of colors.
+///
+/// @param colors The number of colors of a color table.
+/// @return The number of bits, at least 1 and at most 8.
+constexpr std::uint8_t bitsForColors(size_t const colors) noexcept
+{
+    std::uint8_t bits{1U};
+    while ((bits < 8U) && ((1U << bits) < colors))
+    {
+        ++bits;
+    }
+    return bits;
+}
+
+} // namespace Terrahertz::GIF
+
+#endif // !THZ_IMAGE_IO_GIFCOMMONS_HPP
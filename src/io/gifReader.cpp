@@ -0,0 +1,492 @@
+#include "THzImage/io/gifReader.hpp"
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/fstreamhelpers.hpp"
+#include "gifCommons.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Terrahertz::GIF {
+namespace Internal {
+
+constexpr size_t        LZWDecoder::TableSize;
+constexpr std::uint16_t LZWDecoder::NoCode;
+
+/// @brief Reads codes of varying size from the data sub-blocks of the GIF format.
+class SubBlockReader
+{
+public:
+    /// @brief Initializes a new SubBlockReader.
+    ///
+    /// @param data The data sub-blocks.
+    SubBlockReader(gsl::span<std::uint8_t const> const data) noexcept : _data{data} {}
+
+    /// @brief Reads the next code, starting with the least significant bit.
+    ///
+    /// @param size The size of the code [bit].
+    /// @param code The code read.
+    /// @return True if the code was read, false if the data ended.
+    bool read(std::uint32_t const size, std::uint32_t &code) noexcept
+    {
+        while (_bitCount < size)
+        {
+            if (_blockRemaining == 0U)
+            {
+                if ((_position >= _data.size()) || (_data[_position] == 0U))
+                {
+                    return false;
+                }
+                _blockRemaining = _data[_position++];
+            }
+            if (_position >= _data.size())
+            {
+                return false;
+            }
+            _bits |= static_cast<std::uint32_t>(_data[_position++]) << _bitCount;
+            _bitCount += 8U;
+            --_blockRemaining;
+        }
+        code = _bits & ((1U << size) - 1U);
+        _bits >>= size;
+        _bitCount -= size;
+        return true;
+    }
+
+private:
+    /// @brief The data sub-blocks.
+    gsl::span<std::uint8_t const> _data{};
+
+    /// @brief The position of the next byte to read.
+    size_t _position{};
+
+    /// @brief The number of bytes left in the current sub-block.
+    size_t _blockRemaining{};
+
+    /// @brief The bits read but not yet returned.
+    std::uint32_t _bits{};
+
+    /// @brief The number of bits read but not yet returned.
+    std::uint32_t _bitCount{};
+};
+
+LZWDecoder::LZWDecoder() noexcept { resetRoots(); }
+
+void LZWDecoder::resetRoots() noexcept
+{
+    for (auto i = 0U; i < 256U; ++i)
+    {
+        _prefix[i] = NoCode;
+        _suffix[i] = static_cast<std::uint8_t>(i);
+        _first[i]  = static_cast<std::uint8_t>(i);
+        _length[i] = 1U;
+    }
+}
+
+size_t LZWDecoder::decode(std::uint8_t const                  minCodeSize,
+                          gsl::span<std::uint8_t const> const data,
+                          gsl::span<std::uint8_t> const       output) noexcept
+{
+    if ((minCodeSize < 2U) || (minCodeSize > 8U))
+    {
+        return 0U;
+    }
+    auto const clearCode = 1U << minCodeSize;
+    auto const endCode   = clearCode + 1U;
+    auto       codeSize  = minCodeSize + 1U;
+    auto       nextCode  = endCode + 1U;
+    auto       previous  = std::uint32_t{NoCode};
+
+    // a clear code needs no reset, the strings added within one call never replace its own single indices
+    resetRoots();
+
+    SubBlockReader reader{data};
+    size_t         written{};
+    std::uint32_t  code{};
+    while ((written < output.size()) && reader.read(codeSize, code))
+    {
+        if (code == clearCode)
+        {
+            codeSize = minCodeSize + 1U;
+            nextCode = endCode + 1U;
+            previous = NoCode;
+            continue;
+        }
+        if (code == endCode)
+        {
+            break;
+        }
+        if (previous == NoCode)
+        {
+            // the first code after a clear code always is a single index
+            if (code >= clearCode)
+            {
+                break;
+            }
+            output[written++] = static_cast<std::uint8_t>(code);
+            previous          = code;
+            continue;
+        }
+        if (code > nextCode)
+        {
+            break;
+        }
+        if (nextCode < TableSize)
+        {
+            // code == nextCode is the special case of the string being the previous one plus its first index
+            _prefix[nextCode] = static_cast<std::uint16_t>(previous);
+            _suffix[nextCode] = (code == nextCode) ? _first[previous] : _first[code];
+            _first[nextCode]  = _first[previous];
+            _length[nextCode] = _length[previous] + 1U;
+            ++nextCode;
+            if ((nextCode == (1U << codeSize)) && (codeSize < 12U))
+            {
+                ++codeSize;
+            }
+        }
+        else if (code == nextCode)
+        {
+            break;
+        }
+
+        // the string is written back to front by following the prefixes
+        auto const length = std::min<size_t>(_length[code], output.size() - written);
+        auto       entry  = code;
+        for (auto skip = _length[code] - length; skip != 0U; --skip)
+        {
+            entry = _prefix[entry];
+        }
+        for (auto i = length; i != 0U; --i)
+        {
+            output[written + i - 1U] = _suffix[entry];
+            entry                    = _prefix[entry];
+        }
+        written += length;
+        previous = code;
+    }
+    return written;
+}
+
+} // namespace Internal
+
+/// @brief Name provider for the THzImage.IO.GIF.Reader class.
+struct ReaderProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.GIF.Reader"; }
+};
+
+/// @brief Returns the position after the data sub-blocks starting at the given position.
+///
+/// @param data The content of the file.
+/// @param position The position of the first sub-block.
+/// @return The position after the terminating empty sub-block, the size of the data if it is missing.
+static size_t skipSubBlocks(gsl::span<std::uint8_t const> const data, size_t position) noexcept
+{
+    while ((position < data.size()) && (data[position] != 0U))
+    {
+        position += data[position] + 1U;
+    }
+    return std::min(position + 1U, data.size());
+}
+
+/// @brief Returns the row of the image the given row of an interlaced image belongs to.
+///
+/// @param row The row in the order it is stored.
+/// @param height The height of the image.
+/// @return The row of the image.
+static std::uint32_t interlacedRow(std::uint32_t row, std::uint32_t const height) noexcept
+{
+    // pass 1: every 8th row starting with 0, pass 2: every 8th starting with 4,
+    // pass 3: every 4th starting with 2, pass 4: every 2nd starting with 1
+    constexpr std::array<std::uint32_t, 4U> starts{0U, 4U, 2U, 1U};
+    constexpr std::array<std::uint32_t, 4U> steps{8U, 8U, 4U, 2U};
+    for (auto pass = 0U; pass < starts.size(); ++pass)
+    {
+        auto const rows = (height > starts[pass]) ? ((height - starts[pass] + steps[pass] - 1U) / steps[pass]) : 0U;
+        if (row < rows)
+        {
+            return starts[pass] + (row * steps[pass]);
+        }
+        row -= rows;
+    }
+    return height;
+}
+
+Reader::Reader(std::filesystem::path const filepath) noexcept
+{
+    Logger::globalInstance().addProject<ReaderProject>();
+    _stream.open(filepath, std::ios::binary);
+}
+
+Reader::~Reader() noexcept { deinit(); }
+
+bool Reader::fileTypeFits() noexcept
+{
+    std::array<char, 6U> signature{};
+    if (!_data.empty())
+    {
+        return true;
+    }
+    if (!_stream.is_open() || !readFromStream(_stream, signature))
+    {
+        return false;
+    }
+    // reset reader
+    _stream.seekg(0U);
+    return (signature == Header::Signature89a) || (signature == Header::Signature87a);
+}
+
+bool Reader::imagePresent() const noexcept
+{
+    // stream is opened at construction and closed once the file is loaded,
+    // afterwards the file is kept as long as there are frames left
+    return _stream.is_open() || (_position != 0U);
+}
+
+bool Reader::init() noexcept
+{
+    if (_data.empty() && !load())
+    {
+        return false;
+    }
+    if (_position == 0U)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("No frames left to read");
+        return false;
+    }
+    return true;
+}
+
+Rectangle Reader::dimensions() const noexcept { return _dimensions; }
+
+bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
+{
+    if (_position == 0U)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Reader was not initialized");
+        return false;
+    }
+    if (buffer.size() < _dimensions.area())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Given buffer is too small for the data");
+        return false;
+    }
+    gsl::span<std::uint8_t const> const data{_data};
+
+    ImageDescriptor descriptor{};
+    if ((_position + sizeof(ImageDescriptor)) > data.size())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("File too small for the image descriptor");
+        _position = 0U;
+        return false;
+    }
+    std::memcpy(&descriptor, &data[_position], sizeof(ImageDescriptor));
+    auto position = _position + sizeof(ImageDescriptor);
+
+    // expand the color table into a lookup for all possible indices
+    auto   colorTable = _globalColorTable;
+    size_t colors     = _globalColors;
+    if ((descriptor.packedFields & ImageDescriptor::LocalColorTableFlag) != 0U)
+    {
+        colorTable = position;
+        colors     = 2U << (descriptor.packedFields & 0x07U);
+        position += colors * 3U;
+    }
+    if ((position + 1U) > data.size())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("File too small for the color table");
+        _position = 0U;
+        return false;
+    }
+    std::array<BGRAPixel, 256U> lookup{};
+    for (auto i = 0U; (colorTable != 0U) && (i < colors); ++i)
+    {
+        auto const color = &data[colorTable + (i * 3U)];
+        lookup[i]        = BGRAPixel{color[2U], color[1U], color[0U]};
+    }
+
+    // decode the indices of the frame
+    auto const minCodeSize = data[position];
+    auto const frameArea   = static_cast<size_t>(descriptor.width) * descriptor.height;
+    _indices.resize(frameArea);
+    Internal::LZWDecoder decoder{};
+    auto const           decoded = decoder.decode(minCodeSize, data.subspan(position + 1U), _indices);
+    if (decoded != frameArea)
+    {
+        logMessage<LogLevel::Warning, ReaderProject>("Image data incomplete, filling the rest with the first color");
+        std::fill(_indices.begin() + decoded, _indices.end(), std::uint8_t{});
+    }
+    _position = skipSubBlocks(data, position + 1U);
+
+    // dispose the previous frame and compose the new one
+    if (_canvas.empty())
+    {
+        _canvas.resize(_dimensions.area(), BGRAPixel{0U, 0U, 0U, 0U});
+    }
+    else if (_previousDisposal == GraphicControlExtension::RestoreBackground)
+    {
+        for (auto y = 0U; y < _previousRegion.height; ++y)
+        {
+            auto const start = _canvas.begin() + (static_cast<size_t>(_previousRegion.upperLeftPoint.y + y) *
+                                                   _dimensions.width) +
+                               _previousRegion.upperLeftPoint.x;
+            std::fill(start, start + _previousRegion.width, BGRAPixel{0U, 0U, 0U, 0U});
+        }
+    }
+    else if ((_previousDisposal == GraphicControlExtension::RestorePrevious) && !_saved.empty())
+    {
+        std::swap(_canvas, _saved);
+    }
+    if (_disposal == GraphicControlExtension::RestorePrevious)
+    {
+        _saved = _canvas;
+    }
+
+    // parts of the frame outside of the image are ignored
+    auto const left   = std::min<std::uint32_t>(descriptor.left, _dimensions.width);
+    auto const top    = std::min<std::uint32_t>(descriptor.top, _dimensions.height);
+    auto const width  = std::min<std::uint32_t>(descriptor.width, _dimensions.width - left);
+    auto const height = std::min<std::uint32_t>(descriptor.height, _dimensions.height - top);
+    auto const interlaced = (descriptor.packedFields & ImageDescriptor::InterlaceFlag) != 0U;
+    for (auto row = 0U; row < descriptor.height; ++row)
+    {
+        auto const y = interlaced ? interlacedRow(row, descriptor.height) : row;
+        if (y >= height)
+        {
+            continue;
+        }
+        auto const indices = &_indices[static_cast<size_t>(row) * descriptor.width];
+        auto const pixels  = &_canvas[(static_cast<size_t>(top + y) * _dimensions.width) + left];
+        if (_transparency)
+        {
+            for (auto x = 0U; x < width; ++x)
+            {
+                if (indices[x] != _transparentIndex)
+                {
+                    pixels[x] = lookup[indices[x]];
+                }
+            }
+        }
+        else
+        {
+            for (auto x = 0U; x < width; ++x)
+            {
+                pixels[x] = lookup[indices[x]];
+            }
+        }
+    }
+    std::memcpy(buffer.data(), _canvas.data(), _canvas.size() * sizeof(BGRAPixel));
+
+    _previousDisposal = _disposal;
+    _previousRegion   = Rectangle{static_cast<std::int32_t>(left), static_cast<std::int32_t>(top), width, height};
+    locateNextFrame();
+    return true;
+}
+
+void Reader::deinit() noexcept
+{
+    if (_position == 0U)
+    {
+        _stream.close();
+        _data.clear();
+        _data.shrink_to_fit();
+        _canvas.clear();
+        _saved.clear();
+        _indices.clear();
+    }
+}
+
+bool Reader::load() noexcept
+{
+    if (!_stream.is_open())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("File could not be opened");
+        return false;
+    }
+    Header header{};
+    if (!readFromStream(_stream, header))
+    {
+        logMessage<LogLevel::Error, ReaderProject>("File too small for header structure");
+        return false;
+    }
+    if ((header.signature != Header::Signature89a) && (header.signature != Header::Signature87a))
+    {
+        // This has trace log level as we might try the reader on not GIF file to check the format
+        logMessage<LogLevel::Trace, ReaderProject>("Given file is not a GIF file");
+        return false;
+    }
+    if ((header.width == 0U) || (header.height == 0U))
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Image has an area of 0");
+        return false;
+    }
+
+    // read the whole file at once, it is parsed frame by frame
+    _stream.seekg(0, std::ios::end);
+    auto const size = _stream.tellg();
+    _stream.seekg(0);
+    if (size < static_cast<std::streamoff>(sizeof(Header)))
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Unable to determine the size of the file");
+        return false;
+    }
+    _data.resize(static_cast<size_t>(size));
+    if (readFromStream(_stream, gsl::span<std::uint8_t>{_data}) != _data.size())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Unable to read the file");
+        _data.clear();
+        return false;
+    }
+    _stream.close();
+
+    _dimensions       = Rectangle{header.width, header.height};
+    _position         = sizeof(Header);
+    _globalColorTable = 0U;
+    _globalColors     = 0U;
+    if ((header.packedFields & Header::GlobalColorTableFlag) != 0U)
+    {
+        _globalColorTable = _position;
+        _globalColors     = static_cast<std::uint16_t>(2U << (header.packedFields & 0x07U));
+        _position += _globalColors * 3U;
+    }
+    _previousDisposal = 0U;
+    locateNextFrame();
+    if (_position == 0U)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("File does not contain an image");
+        return false;
+    }
+    return true;
+}
+
+void Reader::locateNextFrame() noexcept
+{
+    _disposal     = 0U;
+    _transparency = false;
+    while (_position < _data.size())
+    {
+        auto const block = _data[_position];
+        if (block == ImageSeparator)
+        {
+            return;
+        }
+        if ((block != ExtensionIntroducer) || ((_position + 2U) >= _data.size()))
+        {
+            // trailer or unknown data, there are no more frames to read
+            break;
+        }
+        if ((_data[_position + 1U] == GraphicControlLabel) &&
+            ((_position + sizeof(GraphicControlExtension)) <= _data.size()))
+        {
+            GraphicControlExtension extension{};
+            std::memcpy(&extension, &_data[_position], sizeof(GraphicControlExtension));
+            _disposal         = extension.packedFields & GraphicControlExtension::DisposalMask;
+            _transparency     = (extension.packedFields & GraphicControlExtension::TransparencyFlag) != 0U;
+            _transparentIndex = extension.transparentColorIndex;
+        }
+        _position = skipSubBlocks(_data, _position + 2U);
+    }
+    _position = 0U;
+}
+
+} // namespace Terrahertz::GIF
@@ -1,115 +1,289 @@
 #include "THzImage/io/gifWriter.hpp"
 
-#include "THzCommon/structures/octree.hpp"
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/fstreamhelpers.hpp"
 #include "THzCommon/utility/spanhelpers.hpp"
 #include "THzImage/common/colorspaceconverter.hpp"
+#include "gifCommons.hpp"
+#include "parallelCommons.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
 
 namespace Terrahertz::GIF {
 namespace Internal {
 
-/// @brief The type of octree to reduction is based on.
-using BGROctreeType = Octree<std::uint8_t, std::uint16_t, std::uint8_t>;
+constexpr size_t        ColorReduction::TargetColors;
+constexpr size_t        ColorReduction::QALength;
+constexpr size_t        ColorReduction::QAEntries;
+constexpr size_t        ColorReduction::QASlice;
+constexpr std::uint32_t ColorReduction::InverseBits;
+constexpr size_t        ColorReduction::InverseLength;
 
-constexpr size_t ColorReduction::TargetColors;
-constexpr size_t ColorReduction::QALength;
-constexpr size_t ColorReduction::QAEntries;
-constexpr size_t ColorReduction::QASlice;
+/// @brief The number of bits per channel used by the histogram.
+constexpr std::uint32_t HistogramBits{5U};
 
-void ColorReduction::analyze(gsl::span<BGRAPixel const> const buffer) noexcept
+/// @brief The number of bins of the histogram.
+constexpr size_t HistogramSize{1U << (3U * HistogramBits)};
+
+/// @brief The minimum number of pixels worth starting another thread for.
+constexpr size_t MinPixelsPerThread{1U << 17U};
+
+/// @brief A bin of the color histogram.
+struct HistogramBin
+{
+    /// @brief The number of pixels in the bin.
+    std::uint64_t count{};
+
+    /// @brief The sums of the channels of the pixels in the bin.
+    std::array<std::uint64_t, 3U> sums{};
+};
+
+/// @brief A color of the histogram used for splitting the colorspace.
+struct HistogramColor
+{
+    /// @brief The mean color of the bin, blue, green and red.
+    std::array<std::uint8_t, 3U> color{};
+
+    /// @brief The bin of the histogram.
+    HistogramBin const *bin{};
+};
+
+/// @brief A box of the colorspace, containing a range of the histogram colors.
+struct ColorBox
+{
+    /// @brief The first histogram color of the box.
+    size_t begin{};
+
+    /// @brief The histogram color after the last one of the box.
+    size_t end{};
+
+    /// @brief The number of pixels in the box.
+    std::uint64_t count{};
+
+    /// @brief The channel with the largest range.
+    std::uint32_t channel{};
+
+    /// @brief The range of the channel.
+    std::uint32_t range{};
+};
+
+/// @brief Returns the number of threads to use for processing the given number of items.
+///
+/// @param items The number of items to process.
+/// @param minItemsPerThread The minimum number of items worth starting another thread.
+/// @param maxThreads The maximum number of threads to use.
+/// @return The number of threads to use, at least one.
+static size_t threadsFor(size_t const items, size_t const minItemsPerThread, std::uint32_t const maxThreads) noexcept
 {
-    // build tree
-    BGROctreeType tree{128U, 128U, 128U, 256U, static_cast<std::uint32_t>(buffer.size() / TargetColors), 8U};
+    return std::clamp<size_t>(items / minItemsPerThread, 1U, std::max(maxThreads, 1U));
+}
+
+/// @brief Adds the given pixels to the histogram.
+///
+/// @param buffer The pixels to add.
+/// @param histogram The histogram, needs to have HistogramSize bins.
+static void addToHistogram(gsl::span<BGRAPixel const> const buffer, gsl::span<HistogramBin> const histogram) noexcept
+{
+    constexpr auto Shift = 8U - HistogramBits;
     for (auto const &pixel : buffer)
     {
-        tree.addEntry(pixel.blue, pixel.green, pixel.red, pixel.alpha);
+        auto const key = ((pixel.blue >> Shift) << (2U * HistogramBits)) |
+                         ((pixel.green >> Shift) << HistogramBits) | (pixel.red >> Shift);
+        auto      &bin = histogram[key];
+        ++bin.count;
+        bin.sums[0U] += pixel.blue;
+        bin.sums[1U] += pixel.green;
+        bin.sums[2U] += pixel.red;
+    }
+}
+
+/// @brief Updates count, channel and range of the given box.
+///
+/// @param colors The histogram colors.
+/// @param box The box to update.
+static void measure(gsl::span<HistogramColor const> const colors, ColorBox &box) noexcept
+{
+    std::array<std::uint8_t, 3U> minimum{0xFFU, 0xFFU, 0xFFU};
+    std::array<std::uint8_t, 3U> maximum{};
+    box.count = 0U;
+    for (auto i = box.begin; i < box.end; ++i)
+    {
+        box.count += colors[i].bin->count;
+        for (auto c = 0U; c < 3U; ++c)
+        {
+            minimum[c] = std::min(minimum[c], colors[i].color[c]);
+            maximum[c] = std::max(maximum[c], colors[i].color[c]);
+        }
+    }
+    box.range = 0U;
+    for (auto c = 0U; c < 3U; ++c)
+    {
+        if (static_cast<std::uint32_t>(maximum[c] - minimum[c]) > box.range)
+        {
+            box.channel = c;
+            box.range   = maximum[c] - minimum[c];
+        }
     }
-    tree.recalculate();
+}
 
-    // split tree to fill up  intermediate table
-    std::array<BGROctreeType const *, TargetColors> nodes{};
-    nodes[0U]       = &tree;
-    auto emptySlots = nodes.size() - 1U;
+ColorReduction::ColorReduction(std::uint32_t const threads, bool const exact) noexcept
+    : _threads{threads}, _exact{exact}
+{}
 
-    auto getLargestNodeIndex = [&nodes]() noexcept -> std::uint32_t {
-        auto largestNodeIdx = 0U;
-        for (auto i = 1U; nodes[i] != nullptr; ++i)
+void ColorReduction::analyze(gsl::span<BGRAPixel const> const buffer) noexcept
+{
+    if (buffer.empty())
+    {
+        return;
+    }
+
+    // count the colors in a histogram with 5 bits per channel, large buffers are split between threads
+    auto const                             threads = threadsFor(buffer.size(), MinPixelsPerThread, _threads);
+    std::vector<std::vector<HistogramBin>> histograms(threads);
+    runParallel(threads, threads, [&](size_t const part) noexcept {
+        histograms[part].resize(HistogramSize);
+        auto const begin = (buffer.size() * part) / threads;
+        auto const end   = (buffer.size() * (part + 1U)) / threads;
+        addToHistogram(buffer.subspan(begin, end - begin), histograms[part]);
+    });
+    auto &histogram = histograms[0U];
+    for (auto part = 1U; part < threads; ++part)
+    {
+        for (auto i = 0U; i < HistogramSize; ++i)
         {
-            if (nodes[largestNodeIdx]->totalEntries() < nodes[i]->totalEntries())
+            histogram[i].count += histograms[part][i].count;
+            for (auto c = 0U; c < 3U; ++c)
             {
-                largestNodeIdx = i;
+                histogram[i].sums[c] += histograms[part][i].sums[c];
             }
         }
-        return largestNodeIdx;
-    };
-    auto getEmptyNodeIndex = [&nodes, &emptySlots]() noexcept -> std::uint32_t {
-        for (auto i = 0U; i < nodes.size(); ++i)
+    }
+    std::vector<HistogramColor> colors{};
+    for (auto const &bin : histogram)
+    {
+        if (bin.count != 0U)
         {
-            if (nodes[i] == nullptr)
-            {
-                --emptySlots;
-                return i;
-            }
-            if (nodes[i]->totalEntries() == 0U)
-            {
-                return i;
-            }
+            colors.emplace_back(HistogramColor{{static_cast<std::uint8_t>(bin.sums[0U] / bin.count),
+                                                static_cast<std::uint8_t>(bin.sums[1U] / bin.count),
+                                                static_cast<std::uint8_t>(bin.sums[2U] / bin.count)},
+                                               &bin});
         }
-        return 0U;
-    };
+    }
 
-    while (emptySlots != 0U)
+    // median cut on the weighted colors, always splitting the box with the most pixels times range
+    std::vector<ColorBox> boxes{ColorBox{0U, colors.size()}};
+    boxes.reserve(TargetColors);
+    measure(colors, boxes[0U]);
+    while (boxes.size() < TargetColors)
     {
-        auto parentIdx = getLargestNodeIndex();
-        auto children  = nodes[parentIdx]->getChildNodes();
-        if (children.empty())
+        auto          selected = boxes.size();
+        std::uint64_t maxScore{};
+        for (auto i = 0U; i < boxes.size(); ++i)
+        {
+            auto const score = boxes[i].count * boxes[i].range;
+            if (score > maxScore)
+            {
+                selected = i;
+                maxScore = score;
+            }
+        }
+        if (selected == boxes.size())
         {
-            // if the largest node has no children, we have split all nodes
-            // TODO assumption incorrect largest node can have no children while others still have
+            // all boxes contain a single color
             break;
         }
-        while (emptySlots != 0U)
+        auto      &box     = boxes[selected];
+        auto const channel = box.channel;
+        std::sort(colors.begin() + box.begin,
+                  colors.begin() + box.end,
+                  [channel](HistogramColor const &a, HistogramColor const &b) noexcept {
+                      return a.color[channel] < b.color[channel];
+                  });
+        auto          split = box.begin + 1U;
+        std::uint64_t lower = colors[box.begin].bin->count;
+        while ((split < (box.end - 1U)) && ((lower * 2U) < box.count))
         {
-            if (children.size() > 1U)
-            {
-                nodes[getEmptyNodeIndex()] = &children[0U];
-                children                   = children.subspan(1U);
-            }
-            else
-            {
-                nodes[parentIdx] = &children[0U];
-                break;
-            }
+            lower += colors[split++].bin->count;
         }
+        ColorBox upper{split, box.end};
+        box.end = split;
+        measure(colors, box);
+        measure(colors, upper);
+        boxes.emplace_back(upper);
     }
 
-    // fill _colorTable from intermediate table
+    // fill _colorTable with the mean colors of the boxes
     _colorCount = 0U;
-    for (auto const node : nodes)
+    for (auto const &box : boxes)
     {
-        if (node != nullptr)
+        std::array<std::uint64_t, 3U> sums{};
+        for (auto i = box.begin; i < box.end; ++i)
         {
-            size_t     counter{};
-            float      blue{};
-            float      green{};
-            float      red{};
-            auto      &slot     = _colorTable[_colorCount];
-            auto const anaylzer = [&](BGROctreeType::Entry const &entry) noexcept {
-                ++counter;
-                blue += entry.x;
-                green += entry.y;
-                red += entry.z;
-            };
-            node->analyzeEntries(anaylzer);
-            slot.blue  = static_cast<std::uint8_t>(blue / counter);
-            slot.green = static_cast<std::uint8_t>(green / counter);
-            slot.red   = static_cast<std::uint8_t>(red / counter);
-            ++_colorCount;
+            for (auto c = 0U; c < 3U; ++c)
+            {
+                sums[c] += colors[i].bin->sums[c];
+            }
         }
+        auto const mean = [&box](std::uint64_t const sum) noexcept {
+            return static_cast<std::uint8_t>((sum + (box.count / 2U)) / box.count);
+        };
+        _colorTable[_colorCount++] = BGRAPixel{mean(sums[0U]), mean(sums[1U]), mean(sums[2U])};
+    }
+
+    if (_exact)
+    {
+        updateQuickAccess();
+    }
+    else
+    {
+        updateInverseColormap();
     }
+}
+
+void ColorReduction::updateInverseColormap() noexcept
+{
+    // the squared distance to a color changes by a linear increment from one cell to the next,
+    // so the distances of all cells to all colors are calculated using additions only
+    constexpr std::int32_t Step{1 << (8U - InverseBits)};
+    constexpr std::int32_t Center{Step / 2};
+
+    runParallel(InverseLength, threadsFor(InverseLength, 1U, _threads), [&](size_t const b) noexcept {
+        std::array<std::int32_t, InverseLength * InverseLength> distances{};
+        std::fill(distances.begin(), distances.end(), std::numeric_limits<std::int32_t>::max());
+        auto const indices = &_inverseColormap[b * distances.size()];
+        for (auto i = 0U; i < _colorCount; ++i)
+        {
+            auto const &color     = _colorTable[i];
+            auto const  blue      = Center + static_cast<std::int32_t>(b * Step) - color.blue;
+            auto const  firstRed  = Center - color.red;
+            auto const  increment = (2 * firstRed * Step) + (Step * Step);
+            for (auto g = 0U; g < InverseLength; ++g)
+            {
+                auto const green    = Center + static_cast<std::int32_t>(g * Step) - color.green;
+                auto       distance = (blue * blue) + (green * green) + (firstRed * firstRed);
+                auto       delta    = increment;
+                auto const row      = g * InverseLength;
+                for (auto r = 0U; r < InverseLength; ++r)
+                {
+                    if (distance < distances[row + r])
+                    {
+                        distances[row + r] = distance;
+                        indices[row + r]   = static_cast<std::uint8_t>(i);
+                    }
+                    distance += delta;
+                    delta += 2 * Step * Step;
+                }
+            }
+        }
+    });
+}
 
-    // update quick access
+void ColorReduction::updateQuickAccess() noexcept
+{
+    // one slice of the cube per job
     auto const updateCell = [this](std::array<std::uint8_t, QAEntries> &cell,
                                    std::uint32_t const                  b,
                                    std::uint32_t const                  g,
@@ -150,8 +324,7 @@ void ColorReduction::analyze(gsl::span<BGRAPixel const> const buffer) noexcept
             }
         }
     };
-    for (auto b = 0U; b < _quickAccess.size(); ++b)
-    {
+    runParallel(_quickAccess.size(), threadsFor(_quickAccess.size(), 1U, _threads), [&](size_t const b) noexcept {
         for (auto g = 0U; g < _quickAccess[b].size(); ++g)
         {
             for (auto r = 0U; r < _quickAccess[b][g].size(); ++r)
@@ -159,7 +332,7 @@ void ColorReduction::analyze(gsl::span<BGRAPixel const> const buffer) noexcept
                 updateCell(_quickAccess[b][g][r], b, g, r);
             }
         }
-    }
+    });
 }
 
 gsl::span<BGRAPixel const> ColorReduction::colorTable() const noexcept
@@ -168,6 +341,17 @@ gsl::span<BGRAPixel const> ColorReduction::colorTable() const noexcept
 }
 
 std::uint8_t ColorReduction::convert(BGRAPixel const &color) const noexcept
+{
+    if (_exact)
+    {
+        return convertExact(color);
+    }
+    constexpr auto Shift = 8U - InverseBits;
+    return _inverseColormap[((color.blue >> Shift) << (2U * InverseBits)) | ((color.green >> Shift) << InverseBits) |
+                            (color.red >> Shift)];
+}
+
+std::uint8_t ColorReduction::convertExact(BGRAPixel const &color) const noexcept
 {
     auto minIdx      = 0U;
     auto minDistance = 256ULL * 256U * 4U;
@@ -269,14 +453,719 @@ std::uint8_t Dithering::convert(BGRAPixel color) noexcept
     return result;
 }
 
+/// @brief The thresholds of the ordered dithering, an 8x8 Bayer matrix.
+constexpr std::array<std::array<std::int32_t, 8U>, 8U> BayerMatrix{{{0, 32, 8, 40, 2, 34, 10, 42},
+                                                                    {48, 16, 56, 24, 50, 18, 58, 26},
+                                                                    {12, 44, 4, 36, 14, 46, 6, 38},
+                                                                    {60, 28, 52, 20, 62, 30, 54, 22},
+                                                                    {3, 35, 11, 43, 1, 33, 9, 41},
+                                                                    {51, 19, 59, 27, 49, 17, 57, 25},
+                                                                    {15, 47, 7, 39, 13, 45, 5, 37},
+                                                                    {63, 31, 55, 23, 61, 29, 53, 21}}};
+
+/// @brief The range of the offsets added to the channels by the ordered dithering.
+constexpr std::int32_t OrderedSpread{32};
+
+/// @brief Returns the offset the ordered dithering adds to the channels of the pixel at the given position.
+///
+/// @param x The column of the pixel.
+/// @param y The row of the pixel.
+/// @return The offset, between -OrderedSpread / 2 and OrderedSpread / 2.
+static std::int32_t orderedOffset(std::uint32_t const x, std::uint32_t const y) noexcept
+{
+    return (((2 * BayerMatrix[y % 8U][x % 8U]) + 1 - 64) * OrderedSpread) / 128;
+}
+
+/// @brief Adds the given offset to the channel, keeping it in range.
+///
+/// @param channel The channel to change.
+/// @param offset The offset to add.
+static void addOffset(std::uint8_t &channel, std::int32_t const offset) noexcept
+{
+    channel = static_cast<std::uint8_t>(std::clamp(channel + offset, 0, 255));
+}
+
+OrderedDithering::OrderedDithering(std::uint32_t const threads) noexcept : _threads{threads} {}
+
+void OrderedDithering::setParameters(ColorReduction const &colorReduction) noexcept
+{
+    _colorReduction = &colorReduction;
+}
+
+std::uint8_t OrderedDithering::convert(BGRAPixel color, std::uint32_t const x, std::uint32_t const y) const noexcept
+{
+    if (_colorReduction == nullptr)
+    {
+        return 0U;
+    }
+    auto const offset = orderedOffset(x, y);
+    addOffset(color.blue, offset);
+    addOffset(color.green, offset);
+    addOffset(color.red, offset);
+    return _colorReduction->convert(color);
+}
+
+void OrderedDithering::convert(std::uint32_t const                width,
+                               gsl::span<BGRAPixel const> const buffer,
+                               gsl::span<std::uint8_t> const    indices) const noexcept
+{
+    if ((_colorReduction == nullptr) || (width == 0U) || (indices.size() < buffer.size()))
+    {
+        return;
+    }
+    // rows do not depend on each other, so they are split up evenly between the threads
+    auto const height  = buffer.size() / width;
+    auto const threads = threadsFor(buffer.size(), MinPixelsPerThread, _threads);
+    runParallel(threads, threads, [&](size_t const part) noexcept {
+        std::array<std::int32_t, 8U> offsets{};
+        for (auto y = (height * part) / threads; y < ((height * (part + 1U)) / threads); ++y)
+        {
+            for (auto x = 0U; x < offsets.size(); ++x)
+            {
+                offsets[x] = orderedOffset(x, static_cast<std::uint32_t>(y));
+            }
+            auto const row    = buffer.subspan(y * width, width);
+            auto const output = indices.subspan(y * width, width);
+            for (auto x = 0U; x < width; ++x)
+            {
+                auto color = row[x];
+                addOffset(color.blue, offsets[x % 8U]);
+                addOffset(color.green, offsets[x % 8U]);
+                addOffset(color.red, offsets[x % 8U]);
+                output[x] = _colorReduction->convert(color);
+            }
+        }
+    });
+}
+
+/// @brief Packs codes into bytes and splits them into the data sub-blocks of the GIF format.
+class SubBlockWriter
+{
+public:
+    /// @brief Initializes a new SubBlockWriter.
+    ///
+    /// @param output The buffer to write the sub-blocks to.
+    SubBlockWriter(gsl::span<std::uint8_t> const output) noexcept : _output{output} {}
+
+    /// @brief Writes the given code, starting with the least significant bit.
+    ///
+    /// @param code The code to write.
+    /// @param size The size of the code [bit].
+    void write(std::uint32_t const code, std::uint32_t const size) noexcept
+    {
+        _bits |= code << _bitCount;
+        _bitCount += size;
+        while (_bitCount >= 8U)
+        {
+            putByte(static_cast<std::uint8_t>(_bits));
+            _bits >>= 8U;
+            _bitCount -= 8U;
+        }
+    }
+
+    /// @brief Writes the remaining bits and the terminating empty sub-block.
+    ///
+    /// @return The number of bytes written to the output.
+    size_t finish() noexcept
+    {
+        if (_bitCount != 0U)
+        {
+            putByte(static_cast<std::uint8_t>(_bits));
+            _bits     = 0U;
+            _bitCount = 0U;
+        }
+        if (_blockLength != 0U)
+        {
+            _output[_blockStart] = _blockLength;
+            _blockLength         = 0U;
+        }
+        _output[_size++] = 0U;
+        return _size;
+    }
+
+private:
+    /// @brief Appends the given byte to the current sub-block, starting a new one if necessary.
+    ///
+    /// @param byte The byte to append.
+    void putByte(std::uint8_t const byte) noexcept
+    {
+        if (_blockLength == 0U)
+        {
+            // reserve the length byte of the new sub-block
+            _blockStart = _size++;
+        }
+        _output[_size++] = byte;
+        if (++_blockLength == 255U)
+        {
+            _output[_blockStart] = _blockLength;
+            _blockLength         = 0U;
+        }
+    }
+
+    /// @brief The buffer to write the sub-blocks to.
+    gsl::span<std::uint8_t> _output{};
+
+    /// @brief The number of bytes written to the output.
+    size_t _size{};
+
+    /// @brief The position of the length byte of the current sub-block.
+    size_t _blockStart{};
+
+    /// @brief The number of bytes in the current sub-block.
+    std::uint8_t _blockLength{};
+
+    /// @brief The bits not yet written to the output.
+    std::uint32_t _bits{};
+
+    /// @brief The number of bits not yet written to the output.
+    std::uint32_t _bitCount{};
+};
+
+constexpr std::uint32_t LZWEncoder::MaxCodeSize;
+constexpr size_t        LZWEncoder::DictionarySize;
+constexpr std::uint32_t LZWEncoder::EmptySlot;
+
+size_t LZWEncoder::encode(std::uint8_t const                  minCodeSize,
+                          gsl::span<std::uint8_t const> const indices,
+                          gsl::span<std::uint8_t> const       output) noexcept
+{
+    if ((minCodeSize < 2U) || (minCodeSize > 8U) || (output.size() < maxEncodedSize(indices.size())))
+    {
+        return 0U;
+    }
+    // the largest code, once it is assigned the dictionary is full and has to be cleared
+    constexpr std::uint32_t MaxCode{(1U << MaxCodeSize) - 1U};
+
+    auto const clearCode = 1U << minCodeSize;
+    auto const endCode   = clearCode + 1U;
+    auto       codeSize  = minCodeSize + 1U;
+    auto       lastCode  = endCode;
+
+    SubBlockWriter writer{output};
+    clear();
+    writer.write(clearCode, codeSize);
+    if (!indices.empty())
+    {
+        std::uint32_t current = indices[0U];
+        for (auto const index : indices.subspan(1U))
+        {
+            auto const key  = (current << 8U) | index;
+            auto       slot = ((key * 0x9E3779B1U) >> 19U) & (DictionarySize - 1U);
+            while ((_keys[slot] != EmptySlot) && (_keys[slot] != key))
+            {
+                slot = (slot + 1U) & (DictionarySize - 1U);
+            }
+            if (_keys[slot] == key)
+            {
+                current = _codes[slot];
+                continue;
+            }
+
+            writer.write(current, codeSize);
+            ++lastCode;
+            if (lastCode >= (1U << codeSize))
+            {
+                ++codeSize;
+            }
+            if (lastCode == MaxCode)
+            {
+                writer.write(clearCode, codeSize);
+                clear();
+                codeSize = minCodeSize + 1U;
+                lastCode = endCode;
+            }
+            else
+            {
+                _keys[slot]  = key;
+                _codes[slot] = static_cast<std::uint16_t>(lastCode);
+            }
+            current = index;
+        }
+        writer.write(current, codeSize);
+    }
+    writer.write(endCode, codeSize);
+    return writer.finish();
+}
+
+void LZWEncoder::clear() noexcept { _keys.fill(EmptySlot); }
+
 } // namespace Internal
 
-Writer::Writer(std::string_view const filepath) noexcept {}
+/// @brief Name provider for the THzImage.IO.GIF.Writer class.
+struct WriterProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.GIF.Writer"; }
+};
+
+/// @brief Appends the given structure to the end of the given buffer.
+///
+/// @tparam TType The type of the structure.
+/// @param data The buffer to append to.
+/// @param value The structure to append.
+template <typename TType>
+static void append(std::vector<std::uint8_t> &data, TType const &value) noexcept
+{
+    auto const position = data.size();
+    data.resize(position + sizeof(TType));
+    std::memcpy(data.data() + position, &value, sizeof(TType));
+}
+
+/// @brief The mean color error of a frame that is always accepted when using the global color table.
+constexpr float MinPaletteError{64.0F};
+
+/// @brief Appends the given color table to the end of the given buffer.
+///
+/// @param data The buffer to append to.
+/// @param colorTable The colors of the table.
+/// @param bits The number of bits defining the size of the table, unused entries are filled with black.
+static void appendColorTable(std::vector<std::uint8_t>       &data,
+                             gsl::span<BGRAPixel const> const colorTable,
+                             std::uint8_t const               bits) noexcept
+{
+    for (auto i = 0U; i < (1U << bits); ++i)
+    {
+        auto const color = (i < colorTable.size()) ? colorTable[i] : BGRAPixel{0U, 0U, 0U};
+        data.insert(data.end(), {color.red, color.green, color.blue});
+    }
+}
+
+/// @brief Appends the given color indices as compressed image data to the end of the given buffer.
+///
+/// @param data The buffer to append to.
+/// @param encoder The encoder to compress the indices with.
+/// @param colorBits The number of bits needed for a color index.
+/// @param indices The color indices of the image.
+static void appendImageData(std::vector<std::uint8_t>          &data,
+                            Internal::LZWEncoder               &encoder,
+                            std::uint8_t const                  colorBits,
+                            gsl::span<std::uint8_t const> const indices) noexcept
+{
+    auto const minCodeSize = std::max<std::uint8_t>(colorBits, 2U);
+    data.emplace_back(minCodeSize);
+    auto const position = data.size();
+    data.resize(position + Internal::LZWEncoder::maxEncodedSize(indices.size()));
+    auto const encoded = encoder.encode(minCodeSize, indices, gsl::span<std::uint8_t>{data}.subspan(position));
+    data.resize(position + encoded);
+}
+
+/// @brief Determines the region of the image that changed compared to the previous image.
+///
+/// @param dimensions The dimensions of both images.
+/// @param previous The pixels of the previous image.
+/// @param current The pixels of the current image.
+/// @return The smallest region containing all changed pixels, empty if nothing changed.
+static Rectangle changedRegion(Rectangle const                 &dimensions,
+                               gsl::span<BGRAPixel const> const previous,
+                               gsl::span<BGRAPixel const> const current) noexcept
+{
+    auto const    width = dimensions.width;
+    std::uint32_t top{dimensions.height};
+    std::uint32_t bottom{};
+    std::uint32_t left{width};
+    std::uint32_t right{};
+    for (auto y = 0U; y < dimensions.height; ++y)
+    {
+        auto const offset = static_cast<size_t>(y) * width;
+        if (std::memcmp(&previous[offset], &current[offset], width * sizeof(BGRAPixel)) == 0)
+        {
+            continue;
+        }
+        top    = std::min(top, y);
+        bottom = y + 1U;
+        // only the parts of the row outside the current region need to be checked
+        for (auto x = 0U; x < left; ++x)
+        {
+            if (previous[offset + x] != current[offset + x])
+            {
+                left = x;
+                break;
+            }
+        }
+        for (auto x = width; x > right; --x)
+        {
+            if (previous[offset + x - 1U] != current[offset + x - 1U])
+            {
+                right = x;
+                break;
+            }
+        }
+    }
+    if (top == dimensions.height)
+    {
+        return {};
+    }
+    return Rectangle{static_cast<std::int32_t>(left), static_cast<std::int32_t>(top), right - left, bottom - top};
+}
+
+Writer::Writer(std::filesystem::path const filepath,
+               DitheringMode const         mode,
+               std::uint32_t const         threads,
+               bool const                  exact) noexcept
+    : _filepath{filepath},
+      _colorReduction{threads, exact},
+      _ditheringMode{mode},
+      _orderedDithering{threads},
+      _localReduction{threads, exact}
+{
+    Logger::globalInstance().addProject<WriterProject>();
+}
+
+Writer::~Writer() noexcept
+{
+    if (_animating)
+    {
+        endAnimation();
+    }
+}
+
+bool Writer::init() noexcept { return true; }
+
+bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept
+{
+    if ((dimensions.area() != buffer.size()) || (dimensions.area() == 0U))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image dimensions do not match the given buffer size");
+        return false;
+    }
+    if ((dimensions.width > 0xFFFFU) || (dimensions.height > 0xFFFFU))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image dimensions exceed the limits of the GIF format");
+        return false;
+    }
+    if (_animating)
+    {
+        return writeFrame(dimensions, buffer);
+    }
+
+    _colorReduction.analyze(buffer);
+    auto const colorTable       = _colorReduction.colorTable();
+    auto const transparentIndex = static_cast<std::uint8_t>(colorTable.size());
+
+    auto transparency = false;
+    _indices.resize(buffer.size());
+    if (_ditheringMode == DitheringMode::ordered)
+    {
+        _orderedDithering.setParameters(_colorReduction);
+        _orderedDithering.convert(dimensions.width, buffer, _indices);
+    }
+    else
+    {
+        _dithering.setParameters(dimensions.width, _colorReduction);
+        for (auto i = 0U; i < buffer.size(); ++i)
+        {
+            // the dithering needs to see every pixel to keep track of its position
+            _indices[i] = _dithering.convert(buffer[i]);
+        }
+    }
+    for (auto i = 0U; i < buffer.size(); ++i)
+    {
+        if (buffer[i].alpha == 0U)
+        {
+            _indices[i]  = transparentIndex;
+            transparency = true;
+        }
+    }
+
+    return writeImage(dimensions, colorTable, _indices, transparency, transparentIndex);
+}
+
+bool Writer::write(IndexedImage const &image) noexcept
+{
+    auto const &dimensions = image.dimensions();
+    if (dimensions.area() == 0U)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image is empty");
+        return false;
+    }
+    if ((dimensions.width > 0xFFFFU) || (dimensions.height > 0xFFFFU))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image dimensions exceed the limits of the GIF format");
+        return false;
+    }
+    if (_animating)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Indexed images can not be added to an animation");
+        return false;
+    }
+    auto const palette = image.palette();
+    if (palette.empty())
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image has no palette");
+        return false;
+    }
+    // the encoder would write indices beyond the color table as control codes, corrupting the file
+    auto const indices = image.indices();
+    if (std::any_of(indices.begin(), indices.end(), [&](auto const index) noexcept { return index >= palette.size(); }))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image contains indices outside of its palette");
+        return false;
+    }
+
+    // GIF supports a single transparent color, the first one found is used
+    auto const transparent = std::find_if(
+        palette.begin(), palette.end(), [](BGRAPixel const &color) noexcept { return color.alpha == 0U; });
+    auto const transparentIndex = static_cast<std::uint8_t>(std::distance(palette.begin(), transparent));
+    return writeImage(dimensions, palette, indices, transparent != palette.end(), transparentIndex);
+}
+
+bool Writer::writeImage(Rectangle const                    &dimensions,
+                        gsl::span<BGRAPixel const> const    colorTable,
+                        gsl::span<std::uint8_t const> const indices,
+                        bool const                          transparency,
+                        std::uint8_t const                  transparentIndex) noexcept
+{
+    // the transparent index may be the one following the color table
+    auto const colors    = transparency ? std::max<size_t>(colorTable.size(), transparentIndex + 1U) : colorTable.size();
+    auto const colorBits = bitsForColors(colors);
+
+    _data.clear();
+    _data.reserve(sizeof(Header) + (3U << colorBits) + sizeof(GraphicControlExtension) + sizeof(ImageDescriptor) +
+                  2U + Internal::LZWEncoder::maxEncodedSize(indices.size()));
 
-bool Writer::init() noexcept { return false; }
+    Header header{};
+    header.width        = static_cast<std::uint16_t>(dimensions.width);
+    header.height       = static_cast<std::uint16_t>(dimensions.height);
+    header.packedFields = Header::GlobalColorTableFlag | 0x70U | (colorBits - 1U);
+    append(_data, header);
+    appendColorTable(_data, colorTable, colorBits);
+    if (transparency)
+    {
+        GraphicControlExtension extension{};
+        extension.packedFields          = GraphicControlExtension::TransparencyFlag;
+        extension.transparentColorIndex = transparentIndex;
+        append(_data, extension);
+    }
+    ImageDescriptor descriptor{};
+    descriptor.width  = header.width;
+    descriptor.height = header.height;
+    append(_data, descriptor);
+    appendImageData(_data, _encoder, colorBits, indices);
+    _data.emplace_back(Trailer);
 
-bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept { return false; }
+    std::ofstream stream{_filepath, std::ios::binary};
+    if (!stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
+        return false;
+    }
+    if (!writeToStream(stream, gsl::span<std::uint8_t const>{_data}))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the image data failed");
+        return false;
+    }
+    return true;
+}
 
 void Writer::deinit() noexcept {}
 
+bool Writer::beginAnimation(AnimationOptions const &options) noexcept
+{
+    if (_animating)
+    {
+        logMessage<LogLevel::Error, WriterProject>("An animation is already being written");
+        return false;
+    }
+    _stream.open(_filepath, std::ios::binary);
+    if (!_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
+        return false;
+    }
+    _animation = options;
+    _animating = true;
+    _failed    = false;
+    _previous.clear();
+    _frame.clear();
+    return true;
+}
+
+bool Writer::endAnimation() noexcept
+{
+    if (!_animating)
+    {
+        return false;
+    }
+    auto success = !_failed && !_previous.empty() && flushFrame();
+    if (success)
+    {
+        success = writeToStream(_stream, Trailer);
+    }
+    _stream.close();
+    _animating = false;
+    _previous.clear();
+    _frame.clear();
+    if (!success)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the animation failed");
+    }
+    return success;
+}
+
+bool Writer::writeFrame(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept
+{
+    if (_failed)
+    {
+        return false;
+    }
+    auto const firstFrame = _previous.empty();
+
+    Rectangle region{dimensions.width, dimensions.height};
+    if (firstFrame)
+    {
+        _screen = dimensions;
+        _colorReduction.analyze(buffer);
+    }
+    else
+    {
+        if ((dimensions.width != _screen.width) || (dimensions.height != _screen.height))
+        {
+            logMessage<LogLevel::Error, WriterProject>("All frames of an animation need the same dimensions");
+            return false;
+        }
+        region = changedRegion(dimensions, _previous, buffer);
+        if (region.area() == 0U)
+        {
+            // nothing changed, so the previous frame is simply shown longer
+            GraphicControlExtension extension{};
+            std::memcpy(&extension, _frame.data(), sizeof(GraphicControlExtension));
+            extension.delayTime = static_cast<std::uint16_t>(
+                std::min<std::uint32_t>(std::uint32_t{extension.delayTime} + _animation.delay, 0xFFFFU));
+            std::memcpy(_frame.data(), &extension, sizeof(GraphicControlExtension));
+            return true;
+        }
+    }
+
+    // map the region to the global color table, unchanged pixels become transparent
+    auto const ordered = _ditheringMode == DitheringMode::ordered;
+    _orderedDithering.setParameters(_colorReduction);
+    auto colorTable       = _colorReduction.colorTable();
+    auto transparentIndex = static_cast<std::uint8_t>(colorTable.size());
+    auto transparency     = false;
+    auto error            = 0.0F;
+    _indices.resize(region.area());
+    _changed.clear();
+    auto index = _indices.begin();
+    for (auto y = region.upperLeftPoint.y; y < static_cast<std::int32_t>(region.upperLeftPoint.y + region.height); ++y)
+    {
+        auto const offset = static_cast<size_t>(y) * dimensions.width;
+        for (auto x = region.upperLeftPoint.x; x < static_cast<std::int32_t>(region.upperLeftPoint.x + region.width);
+             ++x, ++index)
+        {
+            auto const &pixel = buffer[offset + x];
+            if (!firstFrame && (pixel == _previous[offset + x]))
+            {
+                *index       = transparentIndex;
+                transparency = true;
+                continue;
+            }
+            *index = ordered ? _orderedDithering.convert(pixel, x, y) : _colorReduction.convert(pixel);
+            error += static_cast<float>(pixel.distanceSquared(colorTable[*index]));
+            _changed.emplace_back(pixel);
+        }
+    }
+    error /= static_cast<float>(_changed.size());
+
+    auto localTable = false;
+    if (firstFrame)
+    {
+        _maxPaletteError = std::max(error, MinPaletteError) * _animation.paletteTolerance;
+    }
+    else if (error > _maxPaletteError)
+    {
+        // the global colors do not fit this frame, give it a color table of its own
+        _localReduction.analyze(_changed);
+        auto const localTransparentIndex = static_cast<std::uint8_t>(_localReduction.colorTable().size());
+        auto       changed               = _changed.cbegin();
+        auto       entry                 = _indices.begin();
+        _orderedDithering.setParameters(_localReduction);
+        for (auto y = region.upperLeftPoint.y; y < static_cast<std::int32_t>(region.upperLeftPoint.y + region.height);
+             ++y)
+        {
+            for (auto x = region.upperLeftPoint.x;
+                 x < static_cast<std::int32_t>(region.upperLeftPoint.x + region.width);
+                 ++x, ++entry)
+            {
+                if (*entry == transparentIndex)
+                {
+                    *entry = localTransparentIndex;
+                    continue;
+                }
+                auto const &pixel = *(changed++);
+                *entry = ordered ? _orderedDithering.convert(pixel, x, y) : _localReduction.convert(pixel);
+            }
+        }
+        colorTable       = _localReduction.colorTable();
+        transparentIndex = localTransparentIndex;
+        localTable       = true;
+    }
+
+    if (firstFrame)
+    {
+        // the global color table always reserves an index for the transparency of the following frames
+        auto const colorBits = bitsForColors(colorTable.size() + 1U);
+        _data.clear();
+        Header header{};
+        header.width        = static_cast<std::uint16_t>(dimensions.width);
+        header.height       = static_cast<std::uint16_t>(dimensions.height);
+        header.packedFields = Header::GlobalColorTableFlag | 0x70U | (colorBits - 1U);
+        append(_data, header);
+        appendColorTable(_data, colorTable, colorBits);
+        LoopExtension loop{};
+        loop.loops = _animation.loops;
+        append(_data, loop);
+        if (!writeToStream(_stream, gsl::span<std::uint8_t const>{_data}))
+        {
+            logMessage<LogLevel::Error, WriterProject>("Writing the header of the animation failed");
+            _failed = true;
+            return false;
+        }
+    }
+    else if (!flushFrame())
+    {
+        return false;
+    }
+
+    auto const colorBits = bitsForColors(colorTable.size() + 1U);
+    _frame.clear();
+    GraphicControlExtension extension{};
+    extension.packedFields =
+        GraphicControlExtension::DoNotDispose | (transparency ? GraphicControlExtension::TransparencyFlag : 0U);
+    extension.delayTime             = _animation.delay;
+    extension.transparentColorIndex = transparentIndex;
+    append(_frame, extension);
+    ImageDescriptor descriptor{};
+    descriptor.left   = static_cast<std::uint16_t>(region.upperLeftPoint.x);
+    descriptor.top    = static_cast<std::uint16_t>(region.upperLeftPoint.y);
+    descriptor.width  = static_cast<std::uint16_t>(region.width);
+    descriptor.height = static_cast<std::uint16_t>(region.height);
+    if (localTable)
+    {
+        descriptor.packedFields = ImageDescriptor::LocalColorTableFlag | (colorBits - 1U);
+    }
+    append(_frame, descriptor);
+    if (localTable)
+    {
+        appendColorTable(_frame, colorTable, colorBits);
+    }
+    appendImageData(_frame, _encoder, colorBits, _indices);
+    _previous.assign(buffer.begin(), buffer.end());
+    return true;
+}
+
+bool Writer::flushFrame() noexcept
+{
+    if (_frame.empty())
+    {
+        return true;
+    }
+    if (!writeToStream(_stream, gsl::span<std::uint8_t const>{_frame}))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the frame failed");
+        _failed = true;
+        return false;
+    }
+    _frame.clear();
+    return true;
+}
+
 } // namespace Terrahertz::GIF
@@ -0,0 +1,286 @@
+#include "THzImage/io/imageCache.hpp"
+
+#include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/fstreamhelpers.hpp"
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/frameFormat.hpp"
+#include "THzImage/io/frameReader.hpp"
+#include "THzImage/io/frameWriter.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace Terrahertz {
+
+/// @brief Name provider for the THzImage.IO.ImageCache class.
+struct ImageCacheProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.ImageCache"; }
+};
+
+/// @brief Returns a path to write the given file to before moving it in place, unique for each call.
+///
+/// @param path The path of the file to write.
+/// @return The temporary path, made up of the given path, the id of the calling thread and a counter.
+static std::filesystem::path temporaryPathFor(std::filesystem::path const &path) noexcept
+{
+    static std::atomic_size_t counter{};
+
+    std::array<char, 48U> suffix{};
+    std::snprintf(suffix.data(),
+                  suffix.size(),
+                  ".%zx.%zx.tmp",
+                  std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                  counter++);
+    auto temporary = path;
+    temporary += suffix.data();
+    return temporary;
+}
+
+/// @brief Appends the given key to the spilled image, behind the pixel data where the frame format ignores it.
+///
+/// @param spilled The path of the spilled image.
+/// @param key The key of the file the image was decoded from.
+/// @return True if the key was appended, false otherwise.
+/// @remarks The key is stored as the size of the file, the ticks of its modification time, the length of the path
+///          and the characters of the path.
+static bool appendKey(std::filesystem::path const &spilled, ImageCache::Key const &key) noexcept
+{
+    std::ofstream stream{spilled, std::ios::binary | std::ios::app};
+    auto const   &path = key.path.native();
+    return stream.is_open() && writeToStream(stream, static_cast<std::uint64_t>(key.fileSize)) &&
+           writeToStream(stream, static_cast<std::int64_t>(key.modified.time_since_epoch().count())) &&
+           writeToStream(stream, static_cast<std::uint64_t>(path.size())) &&
+           writeToStream(stream, gsl::span<std::filesystem::path::value_type const>{path.data(), path.size()});
+}
+
+/// @brief Checks if the spilled image was decoded from the file of the given key.
+///
+/// @param spilled The path of the spilled image.
+/// @param key The key of the file to look up.
+/// @return True if the spilled image exists and its key matches, false otherwise.
+static bool spilledKeyMatches(std::filesystem::path const &spilled, ImageCache::Key const &key) noexcept
+{
+    std::ifstream stream{spilled, std::ios::binary};
+    Frame::Header header{};
+    if (!stream.is_open() || !readFromStream(stream, header) || (header.magic != Frame::Header::MagicBytes))
+    {
+        return false;
+    }
+    stream.seekg(static_cast<std::streamoff>(header.dataOffset + header.dataSize));
+
+    std::uint64_t fileSize{};
+    std::int64_t  modified{};
+    std::uint64_t length{};
+    auto const   &path = key.path.native();
+    if (!readFromStream(stream, fileSize) || !readFromStream(stream, modified) || !readFromStream(stream, length) ||
+        (fileSize != key.fileSize) || (modified != key.modified.time_since_epoch().count()) ||
+        (length != path.size()))
+    {
+        return false;
+    }
+    std::filesystem::path::string_type storedPath(path.size(), {});
+    auto const read = readFromStream(stream, gsl::span<std::filesystem::path::value_type>{storedPath});
+    return (read == storedPath.size()) && (storedPath == path);
+}
+
+ImageCache::ImageCache(size_t const byteBudget, std::filesystem::path const spillDirectory) noexcept
+    : _byteBudget{byteBudget}, _spillDirectory{spillDirectory}
+{
+    Logger::globalInstance().addProject<ImageCacheProject>();
+    if (!_spillDirectory.empty())
+    {
+        std::error_code error{};
+        std::filesystem::create_directories(_spillDirectory, error);
+        if (error)
+        {
+            logMessage<LogLevel::Error, ImageCacheProject>("Unable to create the spill directory, not spilling");
+            _spillDirectory.clear();
+        }
+    }
+}
+
+SharedImage<BGRAPixel> ImageCache::find(std::filesystem::path const &path) noexcept
+{
+    auto const key = keyOf(path);
+    if (!key)
+    {
+        return {};
+    }
+    return find(*key);
+}
+
+SharedImage<BGRAPixel> ImageCache::find(Key const &key) noexcept
+{
+    {
+        std::lock_guard lock{_mutex};
+        auto const      iterator = _index.find(key.path.native());
+        if (iterator != _index.end())
+        {
+            auto const entry = iterator->second;
+            if (entry->key == key)
+            {
+                _entries.splice(_entries.begin(), _entries, entry);
+                return entry->image;
+            }
+            // the file changed since it was cached
+            _usedBytes -= entry->bytes;
+            _entries.erase(entry);
+            _index.erase(iterator);
+        }
+    }
+    if (_spillDirectory.empty())
+    {
+        return {};
+    }
+    // the name of the spilled image is only a hash, so the stored key tells if it belongs to this version of the file
+    auto const spilled = spillPath(key);
+    if (!spilledKeyMatches(spilled, key))
+    {
+        return {};
+    }
+    auto                     image = std::make_shared<Image<BGRAPixel>>();
+    Frame::Reader<BGRAPixel> reader{spilled};
+    if (!image->readFrom(reader))
+    {
+        logMessage<LogLevel::Warning, ImageCacheProject>("Unable to read spilled image");
+        return {};
+    }
+    SharedImage<BGRAPixel> shared{std::move(image)};
+    store(key, shared);
+    return shared;
+}
+
+void ImageCache::insert(std::filesystem::path const &path, SharedImage<BGRAPixel> image) noexcept
+{
+    if (!image)
+    {
+        return;
+    }
+    if (auto const key = keyOf(path))
+    {
+        insert(*key, std::move(image));
+    }
+}
+
+void ImageCache::insert(Key const &key, SharedImage<BGRAPixel> image) noexcept
+{
+    if (!image)
+    {
+        return;
+    }
+    if (!_spillDirectory.empty())
+    {
+        // a spilled image of another file with the same hash is replaced, the most recent one is the likeliest to be
+        // looked up again
+        auto const spilled = spillPath(key);
+        if (!spilledKeyMatches(spilled, key))
+        {
+            // written under a name of its own first, so readers and other writers never see a partially written file
+            auto const               temporary = temporaryPathFor(spilled);
+            Frame::Writer<BGRAPixel> writer{temporary};
+            std::error_code          error{};
+            if (image->writeTo(&writer) && appendKey(temporary, key))
+            {
+                std::filesystem::rename(temporary, spilled, error);
+            }
+            else
+            {
+                logMessage<LogLevel::Warning, ImageCacheProject>("Unable to spill image");
+                std::filesystem::remove(temporary, error);
+            }
+        }
+    }
+    store(key, std::move(image));
+}
+
+size_t ImageCache::size() const noexcept
+{
+    std::lock_guard lock{_mutex};
+    return _entries.size();
+}
+
+size_t ImageCache::usedBytes() const noexcept
+{
+    std::lock_guard lock{_mutex};
+    return _usedBytes;
+}
+
+void ImageCache::clear() noexcept
+{
+    std::lock_guard lock{_mutex};
+    _index.clear();
+    _entries.clear();
+    _usedBytes = 0U;
+}
+
+std::optional<ImageCache::Key> ImageCache::keyOf(std::filesystem::path const &path) noexcept
+{
+    std::error_code error{};
+    Key             key{};
+    key.path = std::filesystem::absolute(path, error).lexically_normal();
+    if (error)
+    {
+        return {};
+    }
+    key.fileSize = std::filesystem::file_size(key.path, error);
+    if (error)
+    {
+        return {};
+    }
+    key.modified = std::filesystem::last_write_time(key.path, error);
+    if (error)
+    {
+        return {};
+    }
+    return key;
+}
+
+std::filesystem::path ImageCache::spillPath(Key const &key) const noexcept
+{
+    auto const combine = [](size_t const seed, size_t const value) noexcept {
+        return seed ^ (value + 0x9E3779B97F4A7C15U + (seed << 6U) + (seed >> 2U));
+    };
+    auto hash = std::hash<std::filesystem::path::string_type>{}(key.path.native());
+    hash      = combine(hash, static_cast<size_t>(key.fileSize));
+    hash      = combine(hash, static_cast<size_t>(key.modified.time_since_epoch().count()));
+
+    std::array<char, 24U> name{};
+    std::snprintf(name.data(), name.size(), "%016llx.thzf", static_cast<unsigned long long>(hash));
+    return _spillDirectory / name.data();
+}
+
+void ImageCache::store(Key const &key, SharedImage<BGRAPixel> image) noexcept
+{
+    auto const bytes = image->dimensions().area() * sizeof(BGRAPixel);
+    if (bytes > _byteBudget)
+    {
+        return;
+    }
+    std::lock_guard lock{_mutex};
+    if (auto const iterator = _index.find(key.path.native()); iterator != _index.end())
+    {
+        _usedBytes -= iterator->second->bytes;
+        _entries.erase(iterator->second);
+        _index.erase(iterator);
+    }
+    while ((_usedBytes + bytes) > _byteBudget)
+    {
+        auto const &oldest = _entries.back();
+        _usedBytes -= oldest.bytes;
+        _index.erase(oldest.key.path.native());
+        _entries.pop_back();
+    }
+    _entries.emplace_front(Entry{key, std::move(image), bytes});
+    _index.emplace(key.path.native(), _entries.begin());
+    _usedBytes += bytes;
+}
+
+} // namespace Terrahertz
@@ -2,6 +2,10 @@
 
 #include "THzCommon/logging/logging.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 namespace Terrahertz::ImageDirectory {
 
 /// @brief Name provider for the THzImage.IO.ImageDirectory.Reader class.
@@ -10,20 +14,54 @@ struct ReaderProject
     static constexpr char const *name() noexcept { return "THzImage.IO.ImageDirectory.Reader"; }
 };
 
-Reader::Reader(std::filesystem::path const directorypath, Reader::Mode const mode) noexcept : _mode{mode}
+Reader::Reader(std::filesystem::path const directorypath,
+               Reader::Mode const          mode,
+               std::uint32_t const         workers,
+               Reader::Order const         order,
+               ImageCache                 *cache) noexcept
+    : _mode{mode}, _order{order}, _cache{cache}
 {
     Logger::globalInstance().addProject<ReaderProject>();
     using ExtensionMode = AutoFile::Reader::ExtensionMode;
-    _iterator           = std::filesystem::recursive_directory_iterator{directorypath};
     _innerReaderMode    = (_mode == Mode::automatic) ? ExtensionMode::lenient : ExtensionMode::strict;
+    _innerReader.setCache(_cache);
+    if (workers == 0U)
+    {
+        _iterator = std::filesystem::recursive_directory_iterator{directorypath};
+        return;
+    }
+    _prefetch   = workers * PrefetchPerWorker;
+    _enumerator = std::thread{[this, directorypath]() noexcept { enumerate(directorypath); }};
+    for (auto i = 0U; i < workers; ++i)
+    {
+        _workers.emplace_back([this]() noexcept { worker(); });
+    }
 }
 
-Reader::~Reader() noexcept { deinit(); }
+Reader::~Reader() noexcept
+{
+    deinit();
+    stopThreads();
+}
 
-bool Reader::imagePresent() const noexcept { return !(_iterator == std::filesystem::end(_iterator)); }
+bool Reader::imagePresent() const noexcept
+{
+    if (_workers.empty())
+    {
+        return !(_iterator == std::filesystem::end(_iterator));
+    }
+    // wait for the enumeration to either find another file or to finish
+    std::unique_lock lock{_mutex};
+    _changed.wait(lock, [this]() noexcept { return (_delivered < _enumerated) || _enumerationFinished || _shutdown; });
+    return !exhausted();
+}
 
 bool Reader::init() noexcept
 {
+    if (!_workers.empty())
+    {
+        return initParallel();
+    }
     for (; imagePresent(); ++_iterator)
     {
         auto const &file = *_iterator;
@@ -31,6 +69,8 @@ bool Reader::init() noexcept
         {
             _pathOfLastImage = file.path();
             _innerReader.reset(_pathOfLastImage, _innerReaderMode);
+            // a failing init resets the inner reader, so the extension has to be checked beforehand
+            auto const extensionSupported = _innerReader.extensionSupported();
 
             if (_innerReader.init())
             {
@@ -39,7 +79,7 @@ bool Reader::init() noexcept
             }
             else if (_mode == Mode::strictExtensionBased)
             {
-                if (_innerReader.extensionSupported())
+                if (extensionSupported)
                 {
                     ++_iterator;
                     return false;
@@ -50,12 +90,161 @@ bool Reader::init() noexcept
     return false;
 }
 
-Rectangle Reader::dimensions() const noexcept { return _innerReader.dimensions(); }
+Rectangle Reader::dimensions() const noexcept
+{
+    if (!_workers.empty())
+    {
+        return _current ? _current->dimensions() : Rectangle{};
+    }
+    return _innerReader.dimensions();
+}
 
-bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept { return _innerReader.read(buffer); }
+bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
+{
+    if (_workers.empty())
+    {
+        return _innerReader.read(buffer);
+    }
+    if (!_current)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Reader was not initialized");
+        return false;
+    }
+    auto const pixels = _current->dimensions().area();
+    if (buffer.size() < pixels)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Given buffer is too small for the data");
+        return false;
+    }
+    std::copy_n(&(*_current)[0U], pixels, buffer.begin());
+    return true;
+}
 
-void Reader::deinit() noexcept { _innerReader.deinit(); }
+void Reader::deinit() noexcept
+{
+    _innerReader.deinit();
+    // hands the buffer back to the pool
+    _current.reset();
+}
 
 std::filesystem::path const &Reader::pathOfLastImage() const noexcept { return _pathOfLastImage; }
 
+void Reader::enumerate(std::filesystem::path const directorypath) noexcept
+{
+    std::error_code error{};
+    for (std::filesystem::recursive_directory_iterator iterator{directorypath, error}, end{}; iterator != end;
+         iterator.increment(error))
+    {
+        if (!iterator->is_regular_file(error))
+        {
+            continue;
+        }
+        std::unique_lock lock{_mutex};
+        // limits the number of decoded images waiting to be delivered
+        _changed.wait(lock, [this]() noexcept { return ((_enumerated - _delivered) < _prefetch) || _shutdown; });
+        if (_shutdown)
+        {
+            return;
+        }
+        _pending.emplace(_enumerated++, iterator->path());
+        _changed.notify_all();
+    }
+    if (error)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Unable to walk the whole directory");
+    }
+    std::lock_guard lock{_mutex};
+    _enumerationFinished = true;
+    _changed.notify_all();
+}
+
+void Reader::worker() noexcept
+{
+    AutoFile::Reader reader{};
+    reader.setCache(_cache);
+    std::unique_lock lock{_mutex};
+    while (true)
+    {
+        _changed.wait(lock, [this]() noexcept { return !_pending.empty() || _enumerationFinished || _shutdown; });
+        if (_shutdown || _pending.empty())
+        {
+            return;
+        }
+        auto node = _pending.extract(_pending.begin());
+        lock.unlock();
+
+        Decoded decoded{std::move(node.mapped()), {}, false};
+        auto    image = _pool.acquire();
+        reader.reset(decoded.path, _innerReaderMode);
+        // a failing read resets the reader, so the extension has to be checked beforehand
+        auto const extensionSupported = reader.extensionSupported();
+        if (image->readFrom(reader))
+        {
+            decoded.image = _pool.publish(std::move(image));
+        }
+        else
+        {
+            // the image is not needed, publishing it without keeping the handle returns it to the pool
+            (void)_pool.publish(std::move(image));
+            decoded.propagateFailure = (_mode == Mode::strictExtensionBased) && extensionSupported;
+        }
+
+        lock.lock();
+        _decoded.emplace(node.key(), std::move(decoded));
+        _changed.notify_all();
+    }
+}
+
+void Reader::stopThreads() noexcept
+{
+    {
+        std::lock_guard lock{_mutex};
+        _shutdown = true;
+    }
+    _changed.notify_all();
+    if (_enumerator.joinable())
+    {
+        _enumerator.join();
+    }
+    for (auto &worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+bool Reader::deliverable() const noexcept
+{
+    if (_decoded.empty())
+    {
+        return false;
+    }
+    return (_order == Order::completion) || (_decoded.begin()->first == _delivered);
+}
+
+bool Reader::exhausted() const noexcept { return _enumerationFinished && (_delivered == _enumerated); }
+
+bool Reader::initParallel() noexcept
+{
+    std::unique_lock lock{_mutex};
+    while (true)
+    {
+        _changed.wait(lock, [this]() noexcept { return deliverable() || exhausted() || _shutdown; });
+        if (!deliverable())
+        {
+            return false;
+        }
+        auto node = _decoded.extract(_decoded.begin());
+        ++_delivered;
+        _changed.notify_all();
+
+        auto &decoded = node.mapped();
+        if (decoded.image || decoded.propagateFailure)
+        {
+            _pathOfLastImage = std::move(decoded.path);
+            _current         = std::move(decoded.image);
+            return static_cast<bool>(_current);
+        }
+    }
+}
+
 } // namespace Terrahertz::ImageDirectory
@@ -0,0 +1,122 @@
+#include "THzImage/io/mappedFile.hpp"
+
+#include "THzCommon/logging/logging.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Terrahertz {
+
+/// @brief Name provider for the THzImage.IO.MappedFile class.
+struct MappedFileProject
+{
+    static constexpr char const *name() noexcept { return "THzImage.IO.MappedFile"; }
+};
+
+MappedFile::~MappedFile() noexcept { close(); }
+
+bool MappedFile::open(std::filesystem::path const &filepath) noexcept
+{
+    Logger::globalInstance().addProject<MappedFileProject>();
+    close();
+#ifdef _WIN32
+    auto const file = CreateFileW(filepath.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        logMessage<LogLevel::Trace, MappedFileProject>("File could not be opened");
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if ((GetFileSizeEx(file, &size) == 0) || (size.QuadPart == 0))
+    {
+        logMessage<LogLevel::Trace, MappedFileProject>("File is empty");
+        CloseHandle(file);
+        return false;
+    }
+    auto const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        logMessage<LogLevel::Error, MappedFileProject>("File could not be mapped");
+        CloseHandle(file);
+        return false;
+    }
+    auto const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        logMessage<LogLevel::Error, MappedFileProject>("File could not be mapped");
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file    = file;
+    _mapping = mapping;
+    _data    = static_cast<std::uint8_t const *>(view);
+    _size    = static_cast<size_t>(size.QuadPart);
+#else
+    auto const file = ::open(filepath.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        logMessage<LogLevel::Trace, MappedFileProject>("File could not be opened");
+        return false;
+    }
+    struct stat status
+    {
+    };
+    if ((fstat(file, &status) != 0) || (status.st_size <= 0))
+    {
+        logMessage<LogLevel::Trace, MappedFileProject>("File is empty");
+        ::close(file);
+        return false;
+    }
+    auto const size = static_cast<size_t>(status.st_size);
+    auto const view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping keeps its own reference to the file
+    ::close(file);
+    if (view == MAP_FAILED)
+    {
+        logMessage<LogLevel::Error, MappedFileProject>("File could not be mapped");
+        return false;
+    }
+    madvise(view, size, MADV_SEQUENTIAL);
+    _data = static_cast<std::uint8_t const *>(view);
+    _size = size;
+#endif
+    return true;
+}
+
+bool MappedFile::isOpen() const noexcept { return _data != nullptr; }
+
+gsl::span<std::uint8_t const> MappedFile::data() const noexcept { return {_data, _size}; }
+
+void MappedFile::close() noexcept
+{
+    if (_data == nullptr)
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(_mapping);
+    CloseHandle(_file);
+    _file    = nullptr;
+    _mapping = nullptr;
+#else
+    munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0U;
+}
+
+} // namespace Terrahertz
@@ -0,0 +1,42 @@
+#ifndef THZ_IMAGE_IO_PARALLELCOMMONS_HPP
+#define THZ_IMAGE_IO_PARALLELCOMMONS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Runs the given function for each job, spread across the given number of threads.
+///
+/// @tparam TFunction The type of function to run.
+/// @param jobs The number of jobs.
+/// @param threads The number of threads to use, the calling thread being one of them.
+/// @param function The function to run, receives the index of the job.
+template <typename TFunction>
+void runParallel(size_t const jobs, size_t const threads, TFunction const &function) noexcept
+{
+    std::atomic_size_t nextJob{};
+    auto const         worker = [&]() noexcept {
+        for (auto job = nextJob++; job < jobs; job = nextJob++)
+        {
+            function(job);
+        }
+    };
+    std::vector<std::thread> helpers{};
+    for (auto i = 1U; i < std::min(threads, jobs); ++i)
+    {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto &helper : helpers)
+    {
+        helper.join();
+    }
+}
+
+} // namespace Terrahertz
+
+#endif // !THZ_IMAGE_IO_PARALLELCOMMONS_HPP
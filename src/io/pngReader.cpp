@@ -2,9 +2,10 @@
 
 #include "THzCommon/logging/logging.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdio>
-#include <cstring>
 #include <png.h>
 #include <vector>
 
@@ -120,6 +121,11 @@ struct Reader::Impl
         {
             png_set_expand_gray_1_2_4_to_8(_png_ptr);
         }
+        if ((color_type & PNG_COLOR_MASK_COLOR) == 0)
+        {
+            // expand gray to rgb as well, so every row ends up as BGRA
+            png_set_gray_to_rgb(_png_ptr);
+        }
         if (png_get_valid(_png_ptr, _info_ptr, PNG_INFO_tRNS) != 0)
         {
             png_set_tRNS_to_alpha(_png_ptr);
@@ -130,12 +136,16 @@ struct Reader::Impl
             png_get_sBIT(_png_ptr, _info_ptr, &sig_bit_p);
             png_set_shift(_png_ptr, sig_bit_p);
         }
-        if ((color_type & PNG_COLOR_MASK_COLOR) != 0)
-        {
-            png_set_bgr(_png_ptr);
-        }
+        png_set_bgr(_png_ptr);
         png_set_filler(_png_ptr, 0xFF, PNG_FILLER_AFTER);
+        _passes = png_set_interlace_handling(_png_ptr);
         png_read_update_info(_png_ptr, _info_ptr);
+        if (png_get_rowbytes(_png_ptr, _info_ptr) != (sizeof(BGRAPixel) * cWidth))
+        {
+            logMessage<LogLevel::Error, ReaderProject>("PNG-file can not be converted to BGRA");
+            return false;
+        }
+        _nextRow = 0U;
 
         dimensions.upperLeftPoint.x = 0;
         dimensions.upperLeftPoint.y = 0;
@@ -146,25 +156,67 @@ struct Reader::Impl
 
     bool read(gsl::span<BGRAPixel> buffer) noexcept
     {
-        std::vector<png_bytep> row_pointers{};
-        row_pointers.resize(dimensions.height);
+        if (buffer.size() < dimensions.area())
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Buffer too small for the image");
+            return false;
+        }
+        if (_nextRow != 0U)
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Image was already read partially using readRows");
+            return false;
+        }
 
-        for (auto row = 0U; row < dimensions.height; row++)
+        // decode directly into the rows of the given buffer
+        std::vector<png_bytep> row_pointers(dimensions.height);
+        for (size_t row = 0U; row < dimensions.height; ++row)
         {
-            row_pointers[row] = (png_bytep)png_malloc(_png_ptr, png_get_rowbytes(_png_ptr, _info_ptr));
+            row_pointers[row] = std::bit_cast<png_bytep>(&buffer[row * dimensions.width]);
+        }
+        if (setjmp(png_jmpbuf(_png_ptr)))
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Decoding the PNG-file failed");
+            return false;
         }
         png_read_image(_png_ptr, row_pointers.data());
         png_read_end(_png_ptr, _info_ptr);
-        for (size_t row = 0U; row < dimensions.height; row++)
+        _nextRow = dimensions.height;
+        return true;
+    }
+
+    std::uint32_t readRows(gsl::span<BGRAPixel> buffer) noexcept
+    {
+        if (_png_ptr == nullptr)
         {
-            memcpy(&(buffer[row * dimensions.width]), row_pointers[row], 4ULL /*32 / 8*/ * dimensions.width);
+            logMessage<LogLevel::Error, ReaderProject>("Reader was not initialized");
+            return 0U;
         }
-
-        for (auto row = 0U; row < dimensions.height; row++)
+        if (_passes != 1)
         {
-            png_free(_png_ptr, row_pointers[row]);
+            logMessage<LogLevel::Error, ReaderProject>("Interlaced images can not be read row by row");
+            return 0U;
         }
-        return true;
+        auto const rows = std::min<std::uint32_t>(static_cast<std::uint32_t>(buffer.size() / dimensions.width),
+                                                  dimensions.height - _nextRow);
+        if (rows == 0U)
+        {
+            return 0U;
+        }
+        if (setjmp(png_jmpbuf(_png_ptr)))
+        {
+            logMessage<LogLevel::Error, ReaderProject>("Decoding the PNG-file failed");
+            return 0U;
+        }
+        for (size_t row = 0U; row < rows; ++row)
+        {
+            png_read_row(_png_ptr, std::bit_cast<png_bytep>(&buffer[row * dimensions.width]), nullptr);
+        }
+        _nextRow += rows;
+        if (_nextRow == dimensions.height)
+        {
+            png_read_end(_png_ptr, _info_ptr);
+        }
+        return rows;
     }
 
     void deinit() noexcept
@@ -188,6 +240,10 @@ struct Reader::Impl
     png_structp _png_ptr{};
 
     png_infop _info_ptr{};
+
+    std::uint32_t _nextRow{};
+
+    int _passes{};
 };
 
 Reader::Reader(std::filesystem::path const filepath) noexcept
@@ -208,6 +264,8 @@ Rectangle Reader::dimensions() const noexcept { return _impl->dimensions; }
 
 bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept { return _impl->read(buffer); }
 
+std::uint32_t Reader::readRows(gsl::span<BGRAPixel> buffer) noexcept { return _impl->readRows(buffer); }
+
 void Reader::deinit() noexcept { _impl->deinit(); }
 
 } // namespace Terrahertz::PNG
@@ -1,9 +1,19 @@
 #include "THzImage/io/pngWriter.hpp"
 
 #include "THzCommon/logging/logging.hpp"
+#include "THzCommon/utility/byteorder.hpp"
+#include "parallelCommons.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <png.h>
+#include <vector>
+#include <zlib.h>
 
 namespace Terrahertz::PNG {
 
@@ -13,7 +23,221 @@ struct WriterProject
     static constexpr char const *name() noexcept { return "THzImage.IO.PNG.Writer"; }
 };
 
-Writer::Writer(std::filesystem::path const filepath) noexcept : _filepath{filepath} {}
+/// @brief Applies the given compression options to the given PNG write structure.
+///
+/// @param png_ptr The PNG write structure.
+/// @param options The options to apply.
+static void applyCompressionOptions(png_structp png_ptr, CompressionOptions const &options) noexcept
+{
+    png_set_compression_level(png_ptr, options.level);
+    switch (options.filter)
+    {
+    case Filter::none:
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+        break;
+    case Filter::sub:
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+        break;
+    case Filter::up:
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_UP);
+        break;
+    case Filter::paeth:
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_PAETH);
+        break;
+    case Filter::adaptive:
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_ALL_FILTERS);
+        break;
+    }
+    switch (options.strategy)
+    {
+    case Strategy::automatic:
+        break;
+    case Strategy::standard:
+        png_set_compression_strategy(png_ptr, Z_DEFAULT_STRATEGY);
+        break;
+    case Strategy::filtered:
+        png_set_compression_strategy(png_ptr, Z_FILTERED);
+        break;
+    case Strategy::rle:
+        png_set_compression_strategy(png_ptr, Z_RLE);
+        break;
+    }
+}
+
+/// @brief The number of bytes per pixel in the PNG-file.
+static constexpr size_t BytesPerPixel{4U};
+
+/// @brief The minimum number of filtered bytes compressed as one band when encoding in parallel.
+static constexpr size_t MinBandSize{128U * 1024U};
+
+/// @brief The size of the deflate window, the end of the previous band is used as dictionary for the next one.
+static constexpr size_t WindowSize{32U * 1024U};
+
+/// @brief The signature at the start of each PNG-file.
+static constexpr std::array<std::uint8_t, 8U> Signature{137U, 'P', 'N', 'G', '\r', '\n', 26U, '\n'};
+
+/// @brief Opens the given file for writing.
+///
+/// @param filepath The path of the file to open.
+/// @return The opened file, nullptr if opening failed.
+static FILE *openFile(std::filesystem::path const &filepath) noexcept
+{
+    FILE *file{};
+#ifdef _WIN32
+    _wfopen_s(&file, filepath.c_str(), L"wb");
+#else
+    file = fopen(filepath.c_str(), "wb");
+#endif
+    return file;
+}
+
+/// @brief Calculates the Paeth predictor for the given bytes.
+///
+/// @param left The byte to the left.
+/// @param up The byte above.
+/// @param upLeft The byte above the left one.
+/// @return The predicted byte.
+static std::uint8_t paethPredictor(std::uint8_t const left, std::uint8_t const up, std::uint8_t const upLeft) noexcept
+{
+    auto const p  = static_cast<int>(left) + up - upLeft;
+    auto const pa = std::abs(p - left);
+    auto const pb = std::abs(p - up);
+    auto const pc = std::abs(p - upLeft);
+    if ((pa <= pb) && (pa <= pc))
+    {
+        return left;
+    }
+    return (pb <= pc) ? up : upLeft;
+}
+
+/// @brief Filters the given row.
+///
+/// @param type The type of filter to apply, one of the PNG_FILTER_VALUE_* constants.
+/// @param row The row to filter.
+/// @param previous The row above the one to filter, all zero for the first row.
+/// @param output The output for the filtered row, starting with the filter type byte.
+static void filterRow(std::uint8_t const                type,
+                      gsl::span<std::uint8_t const> const row,
+                      gsl::span<std::uint8_t const> const previous,
+                      std::uint8_t                       *output) noexcept
+{
+    *output++ = type;
+    for (size_t i = 0U; i < row.size(); ++i)
+    {
+        std::uint8_t const left   = (i < BytesPerPixel) ? 0U : row[i - BytesPerPixel];
+        std::uint8_t const upLeft = (i < BytesPerPixel) ? 0U : previous[i - BytesPerPixel];
+        std::uint8_t       predicted{};
+        switch (type)
+        {
+        case PNG_FILTER_VALUE_SUB:
+            predicted = left;
+            break;
+        case PNG_FILTER_VALUE_UP:
+            predicted = previous[i];
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            predicted = static_cast<std::uint8_t>((left + previous[i]) / 2U);
+            break;
+        case PNG_FILTER_VALUE_PAETH:
+            predicted = paethPredictor(left, previous[i], upLeft);
+            break;
+        default:
+            break;
+        }
+        output[i] = static_cast<std::uint8_t>(row[i] - predicted);
+    }
+}
+
+/// @brief Rates how well the given filtered row will compress, using the heuristic of libpng.
+///
+/// @param filtered The filtered row, without the filter type byte.
+/// @return The sum of the absolute values of the signed bytes, lower is better.
+static size_t rateFilteredRow(gsl::span<std::uint8_t const> const filtered) noexcept
+{
+    size_t sum{};
+    for (auto const value : filtered)
+    {
+        sum += static_cast<size_t>(std::abs(static_cast<std::int8_t>(value)));
+    }
+    return sum;
+}
+
+/// @brief Writes a chunk to the given file.
+///
+/// @param file The file to write to.
+/// @param type The type of the chunk.
+/// @param data The data of the chunk.
+/// @return True if the chunk was written, false otherwise.
+static bool writeChunk(FILE *file, char const *type, gsl::span<std::uint8_t const> const data) noexcept
+{
+    auto const length = flipByteOrder(static_cast<std::uint32_t>(data.size()));
+    auto       crc    = crc32(0UL, std::bit_cast<Bytef const *>(type), 4U);
+    if (!data.empty())
+    {
+        // crc32 resets the checksum if given a nullptr
+        crc = crc32(crc, data.data(), static_cast<uInt>(data.size()));
+    }
+    auto const check = flipByteOrder(static_cast<std::uint32_t>(crc));
+    return (fwrite(&length, sizeof(length), 1U, file) == 1U) && (fwrite(type, 4U, 1U, file) == 1U) &&
+           (fwrite(data.data(), 1U, data.size(), file) == data.size()) &&
+           (fwrite(&check, sizeof(check), 1U, file) == 1U);
+}
+
+struct Writer::Stream
+{
+    /// @brief Cleans up libpng and closes the file.
+    ~Stream() noexcept
+    {
+        if (png_ptr != nullptr)
+        {
+            png_destroy_write_struct(&png_ptr, &info_ptr);
+        }
+        if (pngFile != nullptr)
+        {
+            fclose(pngFile);
+        }
+    }
+
+    Rectangle dimensions{};
+
+    FILE *pngFile{};
+
+    png_structp png_ptr{};
+
+    png_infop info_ptr{};
+
+    std::uint32_t rowsWritten{};
+
+    bool failed{};
+};
+
+Writer::Writer(std::filesystem::path const filepath,
+               CompressionOptions const    options,
+               std::uint32_t const         threads) noexcept
+    : _filepath{filepath}, _threads{threads}
+{
+    setCompressionOptions(options);
+}
+
+void Writer::setCompressionOptions(CompressionOptions const options) noexcept
+{
+    _options = options;
+    if (_options.level > 9U)
+    {
+        logMessage<LogLevel::Warning, WriterProject>("Compression level above 9, using 9 instead");
+        _options.level = 9U;
+    }
+}
+
+Writer::~Writer() noexcept
+{
+    if (_stream)
+    {
+        end();
+    }
+}
+
+CompressionOptions Writer::compressionOptions() const noexcept { return _options; }
 
 bool Writer::init() noexcept { return true; }
 
@@ -24,43 +248,143 @@ bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const
         logMessage<LogLevel::Error, WriterProject>("Image dimensions do not match the given buffer size");
         return false;
     }
+    if ((_threads > 1U) && (buffer.size() != 0U))
+    {
+        return writeParallel(dimensions, buffer);
+    }
+
+    auto const written = begin(dimensions) && writeRows(buffer);
+    return end() && written;
+}
+
+bool Writer::write(IndexedImage const &image) noexcept
+{
+    auto const &dimensions = image.dimensions();
+    auto const  palette    = image.palette();
+    if ((dimensions.area() == 0U) || palette.empty())
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image is empty or has no palette");
+        return false;
+    }
+    auto const indices = image.indices();
+    if (std::any_of(indices.begin(), indices.end(), [&](auto const index) noexcept { return index >= palette.size(); }))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image contains indices outside of its palette");
+        return false;
+    }
+    if (_stream)
+    {
+        logMessage<LogLevel::Error, WriterProject>("An image is already being written");
+        return false;
+    }
 
-    FILE       *pngFile;
-    png_structp png_ptr;
-    png_infop   info_ptr;
+    // small palettes are packed into less bits per pixel by libpng
+    auto const bitDepth = (palette.size() <= 2U) ? 1 : (palette.size() <= 4U) ? 2 : (palette.size() <= 16U) ? 4 : 8;
 
-#ifdef _WIN32
-    _wfopen_s(&pngFile, _filepath.c_str(), L"wb");
-#else
-    pngFile = fopen(_filepath.c_str(), "wb");
-#endif
-    if (pngFile == NULL)
+    std::array<png_color, IndexedImage::MaxColors> colors{};
+    std::array<png_byte, IndexedImage::MaxColors>  alphas{};
+    auto                                           alphaCount = 0;
+    for (auto i = 0U; i < palette.size(); ++i)
+    {
+        colors[i] = png_color{palette[i].red, palette[i].green, palette[i].blue};
+        alphas[i] = palette[i].alpha;
+        if (palette[i].alpha != 0xFFU)
+        {
+            // trailing opaque colors do not need to be stored
+            alphaCount = static_cast<int>(i) + 1;
+        }
+    }
+
+    Stream stream{};
+    stream.pngFile = openFile(_filepath);
+    if (stream.pngFile == nullptr)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
+        return false;
+    }
+    stream.png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (stream.png_ptr == nullptr)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Unable to create PNG write structure");
+        return false;
+    }
+    stream.info_ptr = png_create_info_struct(stream.png_ptr);
+    if (stream.info_ptr == nullptr)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Unable to create PNG info structure");
+        return false;
+    }
+    if (setjmp(png_jmpbuf(stream.png_ptr)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the indexed image failed");
+        return false;
+    }
+    png_init_io(stream.png_ptr, stream.pngFile);
+    applyCompressionOptions(stream.png_ptr, _options);
+    png_set_IHDR(stream.png_ptr,
+                 stream.info_ptr,
+                 dimensions.width,
+                 dimensions.height,
+                 bitDepth,
+                 PNG_COLOR_TYPE_PALETTE,
+                 PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_BASE,
+                 PNG_FILTER_TYPE_BASE);
+    png_set_PLTE(stream.png_ptr, stream.info_ptr, colors.data(), static_cast<int>(palette.size()));
+    if (alphaCount != 0)
+    {
+        png_set_tRNS(stream.png_ptr, stream.info_ptr, alphas.data(), alphaCount, nullptr);
+    }
+    png_write_info(stream.png_ptr, stream.info_ptr);
+    png_set_packing(stream.png_ptr);
+    for (size_t row = 0U; row < dimensions.height; ++row)
+    {
+        png_write_row(stream.png_ptr, &indices[row * dimensions.width]);
+    }
+    png_write_end(stream.png_ptr, stream.info_ptr);
+    return true;
+}
+
+void Writer::deinit() noexcept {}
+
+bool Writer::begin(Rectangle const &dimensions) noexcept
+{
+    if (_stream)
     {
+        logMessage<LogLevel::Error, WriterProject>("An image is already being written");
         return false;
     }
-    png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-    if (png_ptr == NULL)
+    auto stream        = std::make_unique<Stream>();
+    stream->dimensions = dimensions;
+    stream->pngFile    = openFile(_filepath);
+    if (stream->pngFile == nullptr)
     {
-        fclose(pngFile);
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
         return false;
     }
-    info_ptr = png_create_info_struct(png_ptr);
-    if (info_ptr == NULL)
+    stream->png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (stream->png_ptr == nullptr)
     {
-        fclose(pngFile);
-        png_destroy_write_struct(&png_ptr, NULL);
+        logMessage<LogLevel::Error, WriterProject>("Unable to create PNG write structure");
         return false;
     }
-    if (setjmp(png_jmpbuf(png_ptr)))
+    stream->info_ptr = png_create_info_struct(stream->png_ptr);
+    if (stream->info_ptr == nullptr)
     {
-        /* If we get here, we had a problem writing the file */
-        fclose(pngFile);
-        png_destroy_write_struct(&png_ptr, &info_ptr);
+        logMessage<LogLevel::Error, WriterProject>("Unable to create PNG info structure");
         return false;
     }
-    png_init_io(png_ptr, pngFile);
-    png_set_IHDR(png_ptr,
-                 info_ptr,
+    _stream = std::move(stream);
+    if (setjmp(png_jmpbuf(_stream->png_ptr)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the PNG header failed");
+        _stream.reset();
+        return false;
+    }
+    png_init_io(_stream->png_ptr, _stream->pngFile);
+    applyCompressionOptions(_stream->png_ptr, _options);
+    png_set_IHDR(_stream->png_ptr,
+                 _stream->info_ptr,
                  dimensions.width,
                  dimensions.height,
                  8,
@@ -68,30 +392,279 @@ bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const
                  PNG_INTERLACE_NONE,
                  PNG_COMPRESSION_TYPE_BASE,
                  PNG_FILTER_TYPE_BASE);
+    png_write_info(_stream->png_ptr, _stream->info_ptr);
+    png_set_bgr(_stream->png_ptr);
+    return true;
+}
 
-    // write
-    png_write_info(png_ptr, info_ptr);
-    png_set_bgr(png_ptr);
-    if (dimensions.height > PNG_UINT_32_MAX / (sizeof(png_bytep)))
+bool Writer::writeRows(gsl::span<BGRAPixel const> const rows) noexcept
+{
+    if (!_stream || _stream->failed)
     {
-        png_error(png_ptr, "Image is too tall to process in memory");
+        logMessage<LogLevel::Error, WriterProject>("No image is being written");
+        return false;
     }
-
-    auto linePtr = new BGRAPixel const *[dimensions.height];
-    for (auto index = 0ULL; index < dimensions.height; ++index)
+    auto const width = _stream->dimensions.width;
+    auto const count = rows.size() / width;
+    if (((rows.size() % width) != 0U) || (count > (_stream->dimensions.height - _stream->rowsWritten)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Rows do not fit the image");
+        return false;
+    }
+    if (setjmp(png_jmpbuf(_stream->png_ptr)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the rows failed");
+        _stream->failed = true;
+        return false;
+    }
+    for (size_t row = 0U; row < count; ++row)
     {
-        linePtr[index] = &buffer[index * dimensions.width];
+        png_write_row(_stream->png_ptr, std::bit_cast<png_const_bytep>(&rows[row * width]));
     }
-    png_write_image(png_ptr, (png_bytepp)linePtr);
-    png_write_end(png_ptr, info_ptr);
-    delete[] linePtr;
+    _stream->rowsWritten += static_cast<std::uint32_t>(count);
+    return true;
+}
 
-    // clean up
-    png_destroy_write_struct(&png_ptr, &info_ptr);
-    fclose(pngFile);
+bool Writer::end() noexcept
+{
+    if (!_stream)
+    {
+        return false;
+    }
+    if (_stream->failed || (_stream->rowsWritten != _stream->dimensions.height))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image was not written completely");
+        _stream.reset();
+        return false;
+    }
+    // no local state may be changed after setjmp, the error branch therefore finishes on its own
+    if (setjmp(png_jmpbuf(_stream->png_ptr)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Finishing the PNG-file failed");
+        _stream.reset();
+        return false;
+    }
+    png_write_end(_stream->png_ptr, _stream->info_ptr);
+    _stream.reset();
     return true;
 }
 
-void Writer::deinit() noexcept {}
+bool Writer::writeParallel(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept
+{
+    auto const width    = static_cast<size_t>(dimensions.width);
+    auto const height   = static_cast<size_t>(dimensions.height);
+    auto const rowBytes = width * BytesPerPixel;
+    auto const stride   = rowBytes + 1U;
+
+    // filter the rows, each job handling a range of rows
+    std::vector<std::uint8_t> filtered(height * stride);
+
+    // rounding up the rows per job may leave fewer jobs than targeted, so the count is derived from it
+    auto const targetJobs = std::min<size_t>(height, _threads * 4U);
+    auto const rowsPerJob = (height + targetJobs - 1U) / targetJobs;
+    auto const rowJobs    = (height + rowsPerJob - 1U) / rowsPerJob;
+    auto const toRGBA     = [&](size_t const row, std::vector<std::uint8_t> &output) noexcept {
+        auto const *pixel = &buffer[row * width];
+        for (size_t i = 0U; i < rowBytes; i += BytesPerPixel, ++pixel)
+        {
+            output[i]      = pixel->red;
+            output[i + 1U] = pixel->green;
+            output[i + 2U] = pixel->blue;
+            output[i + 3U] = pixel->alpha;
+        }
+    };
+    runParallel(rowJobs, _threads, [&](size_t const job) noexcept {
+        std::vector<std::uint8_t> previous(rowBytes);
+        std::vector<std::uint8_t> current(rowBytes);
+        std::vector<std::uint8_t> candidate(stride);
+
+        auto const firstRow = job * rowsPerJob;
+        auto const lastRow  = std::min(height, firstRow + rowsPerJob);
+        if (firstRow != 0U)
+        {
+            toRGBA(firstRow - 1U, previous);
+        }
+        for (auto row = firstRow; row < lastRow; ++row)
+        {
+            toRGBA(row, current);
+            auto *output = &filtered[row * stride];
+            switch (_options.filter)
+            {
+            case Filter::none:
+                filterRow(PNG_FILTER_VALUE_NONE, current, previous, output);
+                break;
+            case Filter::sub:
+                filterRow(PNG_FILTER_VALUE_SUB, current, previous, output);
+                break;
+            case Filter::up:
+                filterRow(PNG_FILTER_VALUE_UP, current, previous, output);
+                break;
+            case Filter::paeth:
+                filterRow(PNG_FILTER_VALUE_PAETH, current, previous, output);
+                break;
+            case Filter::adaptive:
+            {
+                auto bestRating = std::numeric_limits<size_t>::max();
+                for (std::uint8_t type = PNG_FILTER_VALUE_NONE; type < PNG_FILTER_VALUE_LAST; ++type)
+                {
+                    filterRow(type, current, previous, candidate.data());
+                    auto const rating = rateFilteredRow(gsl::span<std::uint8_t const>{candidate}.subspan(1U));
+                    if (rating < bestRating)
+                    {
+                        bestRating = rating;
+                        std::copy(candidate.cbegin(), candidate.cend(), output);
+                    }
+                }
+                break;
+            }
+            }
+            std::swap(previous, current);
+        }
+    });
+
+    // deflate bands of the filtered data independently, each band ending on a byte boundary thanks to a sync flush
+    // and using the end of the previous band as its dictionary, so the result is a single valid zlib stream
+    auto strategy = (_options.filter == Filter::none) ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+    switch (_options.strategy)
+    {
+    case Strategy::automatic:
+        break;
+    case Strategy::standard:
+        strategy = Z_DEFAULT_STRATEGY;
+        break;
+    case Strategy::filtered:
+        strategy = Z_FILTERED;
+        break;
+    case Strategy::rle:
+        strategy = Z_RLE;
+        break;
+    }
+    auto const bandCount = std::clamp<size_t>(filtered.size() / MinBandSize, 1U, _threads * 4U);
+
+    std::vector<std::vector<std::uint8_t>> bands(bandCount);
+    std::vector<uLong>                     checksums(bandCount);
+    runParallel(bandCount, _threads, [&](size_t const band) noexcept {
+        auto const begin = filtered.size() * band / bandCount;
+        auto const end   = filtered.size() * (band + 1U) / bandCount;
+        auto const last  = (band + 1U) == bandCount;
+
+        checksums[band] = adler32_z(1UL, &filtered[begin], end - begin);
+
+        z_stream stream{};
+        if (deflateInit2(&stream, _options.level, Z_DEFLATED, -MAX_WBITS, 8, strategy) != Z_OK)
+        {
+            return;
+        }
+        if (begin != 0U)
+        {
+            auto const dictionary = begin - std::min(begin, WindowSize);
+            deflateSetDictionary(&stream, &filtered[dictionary], static_cast<uInt>(begin - dictionary));
+        }
+        // the first band leaves room for the zlib header, the last one for the checksum
+        auto &output = bands[band];
+        output.resize(2U + deflateBound(&stream, static_cast<uLong>(end - begin)) + 16U + 4U);
+
+        // zlib counts in uInt, so large bands are fed in pieces and the output grows if the bound does not suffice
+        constexpr size_t MaxPiece{std::numeric_limits<uInt>::max()};
+
+        auto const flush    = last ? Z_FINISH : Z_SYNC_FLUSH;
+        auto       input    = begin;
+        size_t     written  = 0U;
+        auto       complete = false;
+        while (!complete)
+        {
+            if ((stream.avail_in == 0U) && (input != end))
+            {
+                auto const piece = std::min(end - input, MaxPiece);
+                stream.next_in   = &filtered[input];
+                stream.avail_in  = static_cast<uInt>(piece);
+                input += piece;
+            }
+            if ((output.size() - 6U) == written)
+            {
+                output.resize(output.size() * 2U);
+            }
+            auto const available = std::min(output.size() - 6U - written, MaxPiece);
+            stream.next_out      = &output[2U + written];
+            stream.avail_out     = static_cast<uInt>(available);
+
+            auto const allInput = (input == end) && (stream.avail_in == 0U);
+            auto const result   = deflate(&stream, allInput ? flush : Z_NO_FLUSH);
+            written += available - stream.avail_out;
+            if ((result != Z_OK) && (result != Z_STREAM_END))
+            {
+                break;
+            }
+            // a sync flush is only complete once deflate leaves output space unused
+            complete = allInput && (last ? (result == Z_STREAM_END) : (stream.avail_out != 0U));
+        }
+        if (complete)
+        {
+            output.resize(2U + written + (last ? 4U : 0U));
+        }
+        else
+        {
+            output.clear();
+        }
+        deflateEnd(&stream);
+    });
+    if (std::any_of(bands.cbegin(), bands.cend(), [](auto const &band) noexcept { return band.empty(); }))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Compressing the image data failed");
+        return false;
+    }
+
+    // zlib header, compression level hint as written by zlib itself
+    std::uint32_t const levelHint = (_options.level < 2U)    ? 0U
+                                    : (_options.level < 6U)  ? 1U
+                                    : (_options.level == 6U) ? 2U
+                                                             : 3U;
+    std::uint32_t       header    = (0x78U << 8U) | (levelHint << 6U);
+    header += 31U - (header % 31U);
+    bands.front()[0U] = static_cast<std::uint8_t>(header >> 8U);
+    bands.front()[1U] = static_cast<std::uint8_t>(header);
+
+    auto checksum = checksums.front();
+    for (size_t band = 1U; band < bandCount; ++band)
+    {
+        auto const begin = filtered.size() * band / bandCount;
+        auto const end   = filtered.size() * (band + 1U) / bandCount;
+        checksum         = adler32_combine(checksum, checksums[band], static_cast<z_off_t>(end - begin));
+    }
+    auto const storedChecksum = flipByteOrder(static_cast<std::uint32_t>(checksum));
+    std::memcpy(&bands.back()[bands.back().size() - 4U], &storedChecksum, 4U);
+
+    std::array<std::uint8_t, 13U> imageHeader{};
+    auto const                    storedWidth  = flipByteOrder(dimensions.width);
+    auto const                    storedHeight = flipByteOrder(dimensions.height);
+    std::memcpy(&imageHeader[0U], &storedWidth, 4U);
+    std::memcpy(&imageHeader[4U], &storedHeight, 4U);
+    imageHeader[8U]  = 8U;
+    imageHeader[9U]  = PNG_COLOR_TYPE_RGB_ALPHA;
+    imageHeader[10U] = PNG_COMPRESSION_TYPE_BASE;
+    imageHeader[11U] = PNG_FILTER_TYPE_BASE;
+    imageHeader[12U] = PNG_INTERLACE_NONE;
+
+    auto pngFile = openFile(_filepath);
+    if (pngFile == nullptr)
+    {
+        return false;
+    }
+    // each band is stored in an IDAT chunk of its own, only the first one keeps the room for the zlib header
+    auto written = (fwrite(Signature.data(), 1U, Signature.size(), pngFile) == Signature.size()) &&
+                   writeChunk(pngFile, "IHDR", imageHeader);
+    for (size_t band = 0U; written && (band < bandCount); ++band)
+    {
+        auto const data = gsl::span<std::uint8_t const>{bands[band]}.subspan((band == 0U) ? 0U : 2U);
+        written         = writeChunk(pngFile, "IDAT", data);
+    }
+    written = written && writeChunk(pngFile, "IEND", {});
+    fclose(pngFile);
+    if (!written)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the PNG-file failed");
+    }
+    return written;
+}
 
 } // namespace Terrahertz::PNG
@@ -1,6 +1,10 @@
 #ifndef THZ_IMAGE_IO_QOICOMMONS_HPP
 #define THZ_IMAGE_IO_QOICOMMONS_HPP
 
+#include "parallelCommons.hpp"
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace Terrahertz::QOI {
@@ -32,8 +36,34 @@ struct Header
     std::uint8_t colorspace;
 };
 static_assert(sizeof(Header) == 14U, "Header too large");
+
+/// @brief The footer of the chunk index extension, located at the very end of the file.
+///
+/// @remarks A chunked file consists of the header, the chunks, the end marker, one big endian std::uint32_t offset
+///          per chunk (from the start of the file) and this footer. Each chunk covers rowsPerChunk rows (the last
+///          one possibly less) and starts with an OpRGBA, without any OpIndex referring to colors of previous
+///          chunks. This way the chunks form a regular QOI data stream, readers not knowing the extension simply
+///          ignore the data after the end marker.
+struct ChunkIndexFooter
+{
+    /// @brief The value of the magic bytes of the footer.
+    static constexpr std::uint32_t MagicBytes{0x786F6971};
+
+    /// @brief The number of chunks.
+    std::uint32_t chunks{};
+
+    /// @brief The number of rows per chunk.
+    std::uint32_t rowsPerChunk{};
+
+    /// @brief The magic bytes 'qoix'.
+    std::uint32_t magic{};
+};
+static_assert(sizeof(ChunkIndexFooter) == 12U, "ChunkIndexFooter too large");
 #pragma pack()
 
+/// @brief The marker at the end of the QOI data stream.
+constexpr std::array<std::uint8_t, 8U> EndMarker{0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U};
+
 /// @brief Code for index block: 0b00xxxxxx
 constexpr std::uint8_t OpIndex{0x00U};
 
@@ -6,6 +6,11 @@
 #include "THzCommon/utility/spanhelpers.hpp"
 #include "qoiCommons.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
 namespace Terrahertz::QOI {
 namespace Internal {
 
@@ -127,6 +132,89 @@ size_t Decompressor::insertDataChunk(gsl::span<std::uint8_t const> const buffer)
     return readBytes;
 }
 
+size_t Decompressor::decompress(gsl::span<std::uint8_t const> const data, gsl::span<BGRAPixel> const buffer) noexcept
+{
+    ColorTable colorTable{};
+    BGRAPixel  pixel{};
+
+    auto       *output    = buffer.data();
+    auto *const outputEnd = output + buffer.size();
+    auto const *input     = data.data();
+    auto const *inputEnd  = input + data.size();
+    while ((output != outputEnd) && (input != inputEnd))
+    {
+        auto const byte      = *input;
+        auto const remaining = inputEnd - input;
+        if (byte == OpRGB)
+        {
+            if (remaining < 4)
+            {
+                break;
+            }
+            pixel.red   = input[1U];
+            pixel.green = input[2U];
+            pixel.blue  = input[3U];
+            input += 4U;
+        }
+        else if (byte == OpRGBA)
+        {
+            if (remaining < 5)
+            {
+                break;
+            }
+            pixel.red   = input[1U];
+            pixel.green = input[2U];
+            pixel.blue  = input[3U];
+            pixel.alpha = input[4U];
+            input += 5U;
+        }
+        else
+        {
+            switch (byte & Mask2)
+            {
+            case OpIndex:
+                // the color table already contains the pixel, no need to update it
+                pixel     = colorTable[byte];
+                *output++ = pixel;
+                ++input;
+                continue;
+            case OpDiff:
+                pixel.red += ((byte >> 4U) & 0x03U) - 2;
+                pixel.green += ((byte >> 2U) & 0x03U) - 2;
+                pixel.blue += (byte & 0x03U) - 2;
+                ++input;
+                break;
+            case OpLuma: {
+                if (remaining < 2)
+                {
+                    // end the loop as the op is incomplete
+                    input = inputEnd;
+                    continue;
+                }
+                auto const delta  = (byte & ~Mask2) - 32;
+                auto const second = input[1U];
+                pixel.red += delta + ((second >> 4U) & 0x0FU) - 8;
+                pixel.green += delta;
+                pixel.blue += delta + (second & 0x0FU) - 8;
+                input += 2U;
+                break;
+            }
+            default: {
+                // OpRun, the color table needs an update as well, as a run of the start pixel may come first
+                auto const run               = std::min<ptrdiff_t>((byte & ~Mask2) + 1, outputEnd - output);
+                output                       = std::fill_n(output, run, pixel);
+                colorTable[pixelHash(pixel)] = pixel;
+                ++input;
+                continue;
+            }
+            }
+        }
+        colorTable[pixelHash(pixel)] = pixel;
+        *output++                    = pixel;
+    }
+    return static_cast<size_t>(output - buffer.data());
+}
+
 } // namespace Internal
 
 /// @brief Name provider for the THzImage.IO.QOI.Reader class.
@@ -135,7 +223,7 @@ struct ReaderProject
     static constexpr char const *name() noexcept { return "THzImage.IO.QOI.Reader"; }
 };
 
-Reader::Reader(std::filesystem::path const filepath) noexcept
+Reader::Reader(std::filesystem::path const filepath, std::uint32_t const threads) noexcept : _threads{threads}
 {
     Logger::globalInstance().addProject<ReaderProject>();
     _stream.open(filepath, std::ios::binary);
@@ -208,22 +296,101 @@ Rectangle Reader::dimensions() const noexcept { return _dimensions; }
 
 bool Reader::read(gsl::span<BGRAPixel> buffer) noexcept
 {
-    std::array<std::uint8_t, 256U> readBuffer{};
-    Internal::Decompressor         decompressor{};
-    decompressor.setOutputBuffer(buffer);
+    auto const pixels = _dimensions.area();
+    if (buffer.size() < pixels)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Ran out of image buffer space");
+        return false;
+    }
 
-    auto readSpan = toSpan<std::uint8_t>(readBuffer);
-    for (auto bytes = readFromStream(_stream, readBuffer); bytes != 0U; bytes = readFromStream(_stream, readBuffer))
+    // read all the remaining data at once and decompress it in a single pass
+    auto const start = _stream.tellg();
+    _stream.seekg(0, std::ios::end);
+    auto const end = _stream.tellg();
+    _stream.seekg(start);
+    if ((start < 0) || (end < start))
     {
-        if (decompressor.insertDataChunk(readSpan.subspan(0U, bytes)) != bytes)
-        {
-            logMessage<LogLevel::Error, ReaderProject>("Ran out of image buffer space");
-            return false;
-        }
+        logMessage<LogLevel::Error, ReaderProject>("Unable to determine the size of the image data");
+        return false;
+    }
+    std::vector<std::uint8_t> data(static_cast<size_t>(end - start));
+    if (readFromStream(_stream, gsl::span<std::uint8_t>{data}) != data.size())
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Unable to read the image data");
+        return false;
+    }
+    if (readChunked(data, buffer.subspan(0U, pixels)))
+    {
+        return true;
+    }
+    if (Internal::Decompressor::decompress(data, buffer.subspan(0U, pixels)) != pixels)
+    {
+        logMessage<LogLevel::Error, ReaderProject>("Image data incomplete");
+        return false;
     }
     return true;
 }
 
 void Reader::deinit() noexcept { _stream.close(); }
 
+bool Reader::readChunked(gsl::span<std::uint8_t const> const data, gsl::span<BGRAPixel> const buffer) noexcept
+{
+    if (_threads < 2U || (data.size() < sizeof(ChunkIndexFooter)))
+    {
+        return false;
+    }
+    ChunkIndexFooter footer{};
+    std::memcpy(&footer, data.data() + data.size() - sizeof(ChunkIndexFooter), sizeof(ChunkIndexFooter));
+    if (footer.magic != ChunkIndexFooter::MagicBytes)
+    {
+        return false;
+    }
+
+    // everything is validated before decompressing, a broken index falls back to sequential decompression
+    auto const chunks       = flipByteOrder(footer.chunks);
+    auto const rowsPerChunk = flipByteOrder(footer.rowsPerChunk);
+    if ((rowsPerChunk == 0U) || (chunks != ((_dimensions.height + rowsPerChunk - 1U) / rowsPerChunk)))
+    {
+        logMessage<LogLevel::Warning, ReaderProject>("Chunk index does not fit the image, ignoring it");
+        return false;
+    }
+    auto const indexSize = (static_cast<size_t>(chunks) * sizeof(std::uint32_t)) + sizeof(ChunkIndexFooter);
+    if ((indexSize + EndMarker.size()) > data.size())
+    {
+        logMessage<LogLevel::Warning, ReaderProject>("Chunk index does not fit the file, ignoring it");
+        return false;
+    }
+    auto const          indexStart = data.size() - indexSize;
+    std::vector<size_t> offsets(chunks + 1U);
+    for (auto i = 0U; i < chunks; ++i)
+    {
+        std::uint32_t offset{};
+        std::memcpy(&offset, data.data() + indexStart + (i * sizeof(std::uint32_t)), sizeof(std::uint32_t));
+        offsets[i] = static_cast<size_t>(flipByteOrder(offset)) - sizeof(Header);
+    }
+    offsets[chunks] = indexStart - EndMarker.size();
+    if ((offsets[0U] != 0U) || !std::is_sorted(offsets.cbegin(), offsets.cend()))
+    {
+        logMessage<LogLevel::Warning, ReaderProject>("Chunk index is corrupted, ignoring it");
+        return false;
+    }
+
+    auto const       chunkPixels = static_cast<size_t>(rowsPerChunk) * _dimensions.width;
+    std::atomic_bool success{true};
+    runParallel(chunks, _threads, [&](size_t const chunk) noexcept {
+        auto const first  = chunk * chunkPixels;
+        auto const pixels = buffer.subspan(first, std::min(chunkPixels, buffer.size() - first));
+        auto const bytes  = data.subspan(offsets[chunk], offsets[chunk + 1U] - offsets[chunk]);
+        if (Internal::Decompressor::decompress(bytes, pixels) != pixels.size())
+        {
+            success = false;
+        }
+    });
+    if (!success)
+    {
+        logMessage<LogLevel::Warning, ReaderProject>("Image data of a chunk incomplete, ignoring the chunk index");
+    }
+    return success;
+}
+
 } // namespace Terrahertz::QOI
@@ -1,14 +1,56 @@
 #include "THzImage/io/qoiWriter.hpp"
 
 #include "THzCommon/logging/logging.hpp"
-#include "THzCommon/math/inrange.hpp"
 #include "THzCommon/utility/byteorder.hpp"
 #include "THzCommon/utility/fstreamhelpers.hpp"
 #include "qoiCommons.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
 namespace Terrahertz::QOI {
 namespace Internal {
 
+/// @brief The maximum length of a single OpRun.
+constexpr std::uint32_t MaxRun{62U};
+
+static_assert(sizeof(BGRAPixel) == sizeof(std::uint32_t), "BGRAPixel has to be 4 bytes for run detection");
+
+/// @brief Counts the number of pixels equal to the given pixel, starting at begin.
+///
+/// @param begin Pointer to the first pixel to compare.
+/// @param end Pointer to the first pixel after the range to compare.
+/// @param pixel The pixel to compare to.
+/// @return The number of consecutive pixels equal to the given pixel.
+/// @remarks Compares four pixels at a time as long as they match.
+static size_t countEqual(BGRAPixel const *const begin, BGRAPixel const *const end, BGRAPixel const &pixel) noexcept
+{
+    std::uint32_t value{};
+    std::memcpy(&value, &pixel, sizeof(value));
+    std::uint64_t const pair = (static_cast<std::uint64_t>(value) << 32U) | value;
+
+    auto const *current = begin;
+    while ((end - current) >= 4)
+    {
+        std::uint64_t first{};
+        std::uint64_t second{};
+        std::memcpy(&first, current, sizeof(first));
+        std::memcpy(&second, current + 2U, sizeof(second));
+        if (((first ^ pair) | (second ^ pair)) != 0U)
+        {
+            break;
+        }
+        current += 4U;
+    }
+    while ((current != end) && (*current == pixel))
+    {
+        ++current;
+    }
+    return static_cast<size_t>(current - begin);
+}
+
 Compressor::Compressor() noexcept { reset(); }
 
 void Compressor::reset() noexcept
@@ -22,82 +64,133 @@ void Compressor::reset() noexcept
 
 gsl::span<std::uint8_t const> Compressor::nextPixel(BGRAPixel const &pixel) noexcept
 {
-    auto const channelDelta = [](std::uint8_t is, std::uint8_t was) noexcept -> std::int32_t {
-        auto const d = is - was;
-        if (d >= 128)
-        {
-            // this handles diff values if over-/underflow is involved
-            is += 128;
-            was += 128;
-            return is - was;
-        }
-        return d;
-    };
-    auto       length        = 0U;
-    auto const writeToBuffer = [&](std::uint32_t const byte) noexcept {
-        _codeBuffer[length] = static_cast<std::uint8_t>(byte);
-        ++length;
-    };
-    auto const writeRun = [&]() noexcept {
-        writeToBuffer(OpRun | (_run - 1U));
-        _run = 0U;
-    };
-
     if (_lastPixel == pixel)
     {
-        if (++_run == 62U)
+        if (++_run == MaxRun)
         {
-            writeRun();
+            _codeBuffer[0U] = OpRun | (MaxRun - 1U);
+            _run            = 0U;
             return _codeSpan.subspan(0U, 1U);
         }
         return {};
     }
+    auto const *end = encode(pixel, _codeBuffer.data());
+    return _codeSpan.subspan(0U, static_cast<size_t>(end - _codeBuffer.data()));
+}
+
+size_t Compressor::compress(gsl::span<BGRAPixel const> const pixels, gsl::span<std::uint8_t> const output) noexcept
+{
+    if (output.size() < maxCompressedSize(pixels.size()))
+    {
+        return 0U;
+    }
+    auto       *out     = output.data();
+    auto const *current = pixels.data();
+    auto const *end     = current + pixels.size();
+    while (current != end)
+    {
+        if (*current == _lastPixel)
+        {
+            auto const run = countEqual(current, end, _lastPixel);
+            current += run;
+            auto total = _run + run;
+            for (; total >= MaxRun; total -= MaxRun)
+            {
+                *out++ = OpRun | (MaxRun - 1U);
+            }
+            _run = static_cast<std::uint8_t>(total);
+            continue;
+        }
+        out = encode(*current, out);
+        ++current;
+    }
+    return static_cast<size_t>(out - output.data());
+}
 
+std::uint8_t *Compressor::encode(BGRAPixel const &pixel, std::uint8_t *output) noexcept
+{
     if (_run > 0U)
     {
-        writeRun();
+        *output++ = OpRun | (_run - 1U);
+        _run      = 0U;
     }
-    auto const index   = pixelHash(pixel);
-    auto const deltaR  = channelDelta(pixel.red, _lastPixel.red);
-    auto const deltaG  = channelDelta(pixel.green, _lastPixel.green);
-    auto const deltaB  = channelDelta(pixel.blue, _lastPixel.blue);
-    auto const deltaGR = deltaR - deltaG;
-    auto const deltaGB = deltaB - deltaG;
+    auto const index = pixelHash(pixel);
     if (_colorTable[index] == pixel)
     {
-        writeToBuffer(OpIndex | index);
+        *output++ = OpIndex | index;
     }
     else if (_lastPixel.alpha == pixel.alpha)
     {
-        if (inRange(deltaR, -2, 1) && inRange(deltaG, -2, 1) && inRange(deltaB, -2, 1))
+        // deltas wrap around, as the decoder wraps around as well
+        std::int32_t const deltaR  = static_cast<std::int8_t>(pixel.red - _lastPixel.red);
+        std::int32_t const deltaG  = static_cast<std::int8_t>(pixel.green - _lastPixel.green);
+        std::int32_t const deltaB  = static_cast<std::int8_t>(pixel.blue - _lastPixel.blue);
+        std::int32_t const deltaGR = deltaR - deltaG;
+        std::int32_t const deltaGB = deltaB - deltaG;
+
+        // biased values are in range if they are below the limit, negative values turn into large unsigned values
+        auto const biasedR = static_cast<std::uint32_t>(deltaR + 2);
+        auto const biasedG = static_cast<std::uint32_t>(deltaG + 2);
+        auto const biasedB = static_cast<std::uint32_t>(deltaB + 2);
+        if ((biasedR | biasedG | biasedB) < 4U)
         {
-            writeToBuffer(OpDiff | ((deltaR + 2U) << 4U) | ((deltaG + 2U) << 2U) | (deltaB + 2U));
+            *output++ = static_cast<std::uint8_t>(OpDiff | (biasedR << 4U) | (biasedG << 2U) | biasedB);
         }
-        else if (inRange(deltaG, -32, 31) && inRange(deltaGR, -8, 7) && inRange(deltaGB, -8, 7))
+        else if ((static_cast<std::uint32_t>(deltaG + 32) < 64U) &&
+                 ((static_cast<std::uint32_t>(deltaGR + 8) | static_cast<std::uint32_t>(deltaGB + 8)) < 16U))
         {
-            writeToBuffer(OpLuma | (deltaG + 32U));
-            writeToBuffer(((deltaGR + 8U) << 4U) | (deltaGB + 8U));
+            output[0U] = static_cast<std::uint8_t>(OpLuma | (deltaG + 32));
+            output[1U] = static_cast<std::uint8_t>(((deltaGR + 8) << 4U) | (deltaGB + 8));
+            output += 2U;
         }
         else
         {
-            writeToBuffer(OpRGB);
-            writeToBuffer(pixel.red);
-            writeToBuffer(pixel.green);
-            writeToBuffer(pixel.blue);
+            output[0U] = OpRGB;
+            output[1U] = pixel.red;
+            output[2U] = pixel.green;
+            output[3U] = pixel.blue;
+            output += 4U;
         }
     }
     else
     {
-        writeToBuffer(OpRGBA);
-        writeToBuffer(pixel.red);
-        writeToBuffer(pixel.green);
-        writeToBuffer(pixel.blue);
-        writeToBuffer(pixel.alpha);
+        output[0U] = OpRGBA;
+        output[1U] = pixel.red;
+        output[2U] = pixel.green;
+        output[3U] = pixel.blue;
+        output[4U] = pixel.alpha;
+        output += 5U;
     }
 
     _lastPixel         = pixel;
     _colorTable[index] = pixel;
-    return _codeSpan.subspan(0U, length);
+    return output;
+}
+
+size_t Compressor::compressChunk(gsl::span<BGRAPixel const> const pixels, gsl::span<std::uint8_t> const output) noexcept
+{
+    if (pixels.empty() || (output.size() < (maxCompressedSize(pixels.size()) + 1U)))
+    {
+        return 0U;
+    }
+    // filling the table with the first pixel prevents OpIndex codes referring to colors of previous chunks,
+    // as the only color matching an unwritten entry is the first pixel which is written using OpRGBA
+    auto const &first = pixels[0U];
+    _run              = 0U;
+    _lastPixel        = first;
+    _colorTable.fill(first);
+    output[0U] = OpRGBA;
+    output[1U] = first.red;
+    output[2U] = first.green;
+    output[3U] = first.blue;
+    output[4U] = first.alpha;
+
+    auto size = 5U + compress(pixels.subspan(1U), output.subspan(5U));
+    for (auto const byte : flush())
+    {
+        output[size++] = byte;
+    }
+    return size;
 }
 
 gsl::span<std::uint8_t const> Compressor::flush() noexcept
@@ -120,7 +213,9 @@ struct WriterProject
     static constexpr char const *name() noexcept { return "THzImage.IO.QOIWriter"; }
 };
 
-Writer::Writer(std::filesystem::path const filepath) noexcept : _filepath{filepath} {}
+Writer::Writer(std::filesystem::path const filepath, std::uint32_t const threads) noexcept
+    : _filepath{filepath}, _threads{threads}
+{}
 
 bool Writer::init() noexcept { return true; }
 
@@ -144,16 +239,156 @@ bool Writer::write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const
     header.height     = flipByteOrder(dimensions.height);
     header.channels   = 4U;
     header.colorspace = 0U;
-    writeToStream(stream, header);
+    // images without pixels are written as plain QOI-Files, as there is nothing to split into chunks
+    if ((_threads != 0U) && (buffer.size() != 0U))
+    {
+        if (!writeToStream(stream, header))
+        {
+            logMessage<LogLevel::Error, WriterProject>("Writing the header failed");
+            return false;
+        }
+        return writeChunked(stream, dimensions, buffer);
+    }
+
+    // compress everything into a single buffer sized for the worst case and write it in one go
+    std::vector<std::uint8_t> data(sizeof(Header) + Internal::Compressor::maxCompressedSize(buffer.size()) + 1U);
+    std::memcpy(data.data(), &header, sizeof(Header));
     Internal::Compressor compressor{};
-    for (auto const &pixel : buffer)
+    auto                 size = sizeof(Header);
+    size += compressor.compress(buffer, gsl::span<std::uint8_t>{data}.subspan(size));
+    for (auto const byte : compressor.flush())
+    {
+        data[size++] = byte;
+    }
+    if (!writeToStream(stream, gsl::span<std::uint8_t const>{data}.subspan(0U, size)))
     {
-        writeToStream(stream, compressor.nextPixel(pixel));
+        logMessage<LogLevel::Error, WriterProject>("Writing the image data failed");
+        return false;
+    }
+    return true;
+}
+
+bool Writer::writeChunked(std::ofstream                   &stream,
+                          Rectangle const                 &dimensions,
+                          gsl::span<BGRAPixel const> const buffer) noexcept
+{
+    // use more chunks than threads so the work is balanced and readers with more threads benefit as well
+    auto const targetChunks = std::min<std::uint32_t>(_threads * 4U, dimensions.height);
+    auto const rowsPerChunk = (dimensions.height + targetChunks - 1U) / targetChunks;
+    auto const chunkCount   = (dimensions.height + rowsPerChunk - 1U) / rowsPerChunk;
+    auto const chunkPixels  = static_cast<size_t>(rowsPerChunk) * dimensions.width;
+
+    std::vector<std::vector<std::uint8_t>> chunks(chunkCount);
+    runParallel(chunkCount, _threads, [&](size_t const chunk) noexcept {
+        auto const first  = chunk * chunkPixels;
+        auto const pixels = buffer.subspan(first, std::min(chunkPixels, buffer.size() - first));
+        auto      &data   = chunks[chunk];
+        data.resize(Internal::Compressor::maxCompressedSize(pixels.size()) + 1U);
+        Internal::Compressor compressor{};
+        data.resize(compressor.compressChunk(pixels, data));
+    });
+
+    std::vector<std::uint32_t> index(chunkCount);
+    size_t                     offset = sizeof(Header);
+    for (auto i = 0U; i < chunkCount; ++i)
+    {
+        if (offset > std::numeric_limits<std::uint32_t>::max())
+        {
+            logMessage<LogLevel::Error, WriterProject>("Image data too large for the chunk index");
+            return false;
+        }
+        index[i] = flipByteOrder(static_cast<std::uint32_t>(offset));
+        offset += chunks[i].size();
+        if (!writeToStream(stream, gsl::span<std::uint8_t const>{chunks[i]}))
+        {
+            logMessage<LogLevel::Error, WriterProject>("Writing the image data failed");
+            return false;
+        }
+    }
+
+    ChunkIndexFooter footer{};
+    footer.chunks       = flipByteOrder(chunkCount);
+    footer.rowsPerChunk = flipByteOrder(rowsPerChunk);
+    footer.magic        = ChunkIndexFooter::MagicBytes;
+    if (!writeToStream(stream, EndMarker) || !writeToStream(stream, gsl::span<std::uint32_t const>{index}) ||
+        !writeToStream(stream, footer))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the chunk index failed");
+        return false;
     }
-    writeToStream(stream, compressor.flush());
     return true;
 }
 
 void Writer::deinit() noexcept {}
 
+bool Writer::begin(Rectangle const &dimensions) noexcept
+{
+    if (_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("An image is already being written");
+        return false;
+    }
+    if (dimensions.area() == 0U)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image dimensions are empty");
+        return false;
+    }
+    _stream.open(_filepath, std::ios::binary);
+    if (!_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("Could not open the file to write");
+        return false;
+    }
+    _streamDimensions = dimensions;
+    _rowsWritten      = 0U;
+    _compressor.reset();
+
+    Header header{};
+    header.magic      = Header::MagicBytes;
+    header.width      = flipByteOrder(dimensions.width);
+    header.height     = flipByteOrder(dimensions.height);
+    header.channels   = 4U;
+    header.colorspace = 0U;
+    return writeToStream(_stream, header);
+}
+
+bool Writer::writeRows(gsl::span<BGRAPixel const> const rows) noexcept
+{
+    if (!_stream.is_open())
+    {
+        logMessage<LogLevel::Error, WriterProject>("No image is being written");
+        return false;
+    }
+    auto const count = rows.size() / _streamDimensions.width;
+    if (((rows.size() % _streamDimensions.width) != 0U) || (count > (_streamDimensions.height - _rowsWritten)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Rows do not fit the image");
+        return false;
+    }
+    _compressed.resize(Internal::Compressor::maxCompressedSize(rows.size()));
+    auto const size = _compressor.compress(rows, _compressed);
+    if (!writeToStream(_stream, gsl::span<std::uint8_t const>{_compressed}.subspan(0U, size)))
+    {
+        logMessage<LogLevel::Error, WriterProject>("Writing the image data failed");
+        return false;
+    }
+    _rowsWritten += static_cast<std::uint32_t>(count);
+    return true;
+}
+
+bool Writer::end() noexcept
+{
+    if (!_stream.is_open())
+    {
+        return false;
+    }
+    auto success = (_rowsWritten == _streamDimensions.height) && writeToStream(_stream, _compressor.flush());
+    if (!success)
+    {
+        logMessage<LogLevel::Error, WriterProject>("Image was not written completely");
+    }
+    _stream.close();
+    return success;
+}
+
 } // namespace Terrahertz::QOI
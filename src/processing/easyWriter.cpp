@@ -2,9 +2,13 @@
 
 namespace Terrahertz::ImageProcessing {
 
-EasyWriter::EasyWriter(std::filesystem::path const filepath) noexcept
+EasyWriter::EasyWriter(std::filesystem::path const filepath, PNG::CompressionOptions const options) noexcept
 {
     _writer = ImageSeries::Writer<PNG::Writer>::createWriter(filepath.string());
+    if (_writer)
+    {
+        _writer->configure([options](PNG::Writer &writer) { writer.setCompressionOptions(options); });
+    }
     // maybe extract filename generation from imageserieswriter to replicate names for appending
 }
 
@@ -2,8 +2,12 @@
 
 namespace Terrahertz::ImageProcessing {
 
-FileInputNode::FileInputNode(size_t const bufferSize, std::filesystem::path const &path, Mode const mode) noexcept
-    : _reader{path, mode}, _buffer{_reader, bufferSize}
+FileInputNode::FileInputNode(size_t const                 bufferSize,
+                             std::filesystem::path const &path,
+                             Mode const                   mode,
+                             std::uint32_t const          workers,
+                             ImageCache                  *cache) noexcept
+    : _reader{path, mode, workers, ImageDirectory::Reader::Order::directory, cache}, _buffer{_reader, bufferSize}
 {
     _paths.resize(bufferSize);
     _pathMap.resize(bufferSize);
@@ -53,7 +57,7 @@ ToCountResult FileInputNode::toCount(size_t const target, bool const force) noex
     return ToCountResult::Updated;
 }
 
-FileInputNode::ImageType &FileInputNode::operator[](size_t const index) noexcept
+FileInputNode::ImageType const &FileInputNode::operator[](size_t const index) noexcept
 {
     if (index < _buffer.slots())
     {
@@ -62,6 +66,15 @@ FileInputNode::ImageType &FileInputNode::operator[](size_t const index) noexcept
     return _emptyImage;
 }
 
+SharedImage<BGRAPixel> FileInputNode::share(size_t const index) noexcept
+{
+    if (index < _buffer.slots())
+    {
+        return _buffer.share(index);
+    }
+    return {};
+}
+
 size_t FileInputNode::slots() const noexcept { return _buffer.slots(); }
 
 size_t FileInputNode::count() const noexcept { return _buffer.count(); }
@@ -22,7 +22,7 @@ ToCountResult ImageInputNode::toCount(size_t const target, bool) noexcept
     return ToCountResult::Updated;
 }
 
-ImageInputNode::ImageType &ImageInputNode::operator[](size_t const) noexcept { return _image; }
+ImageInputNode::ImageType const &ImageInputNode::operator[](size_t const) noexcept { return _image; }
 
 size_t ImageInputNode::slots() const noexcept { return 1U; }
 
@@ -35,7 +35,7 @@ ToCountResult ScreenInputNode::toCount(size_t const target, bool const force) no
     return ToCountResult::Updated;
 }
 
-ScreenInputNode::ImageType &ScreenInputNode::operator[](size_t const index) noexcept
+ScreenInputNode::ImageType const &ScreenInputNode::operator[](size_t const index) noexcept
 {
     if (index < _buffer.slots())
     {
@@ -44,6 +44,15 @@ ScreenInputNode::ImageType &ScreenInputNode::operator[](size_t const index) noex
     return _emptyImage;
 }
 
+SharedImage<BGRAPixel> ScreenInputNode::share(size_t const index) noexcept
+{
+    if (index < _buffer.slots())
+    {
+        return _buffer.share(index);
+    }
+    return {};
+}
+
 size_t ScreenInputNode::slots() const noexcept { return _buffer.slots(); }
 
 size_t ScreenInputNode::count() const noexcept { return _buffer.count(); }
@@ -2,12 +2,17 @@
 
 #include "THzImage/io/testImageGenerator.hpp"
 
+#include <memory>
+#include <utility>
+
 namespace Terrahertz::ImageProcessing {
 
 TestInputNode::TestInputNode(Rectangle const &dimensions) noexcept
 {
     TestImageGenerator generator{dimensions};
-    (void)_image.readFrom(generator);
+    auto               image = std::make_shared<BGRAImage>();
+    (void)image->readFrom(generator);
+    _image = SharedImage<BGRAPixel>{std::move(image)};
 }
 
 bool TestInputNode::next(bool) noexcept
@@ -30,7 +35,9 @@ ToCountResult TestInputNode::toCount(size_t const target, bool) noexcept
     return ToCountResult::Updated;
 }
 
-TestInputNode::ImageType &TestInputNode::operator[](size_t const) noexcept { return _image; }
+TestInputNode::ImageType const &TestInputNode::operator[](size_t const) noexcept { return *_image; }
+
+SharedImage<BGRAPixel> TestInputNode::share(size_t const) noexcept { return _image; }
 
 size_t TestInputNode::slots() const noexcept { return 1U; }
 
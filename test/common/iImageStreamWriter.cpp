@@ -0,0 +1,140 @@
+#include "THzImage/common/iImageStreamWriter.hpp"
+
+#include "THzCommon/math/rectangle.hpp"
+#include "THzImage/common/iImageTransformer.hpp"
+#include "THzImage/common/imageView.hpp"
+#include "THzImage/common/pixel.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct CommonIImageStreamWriter : public testing::Test
+{
+    class TestWriter : public IImageStreamWriter<BGRAPixel>
+    {
+    public:
+        bool begin(Rectangle const &dimensions) noexcept override
+        {
+            ++beginCalls;
+            this->dimensions = dimensions;
+            return beginResult;
+        }
+
+        bool writeRows(gsl::span<BGRAPixel const> const rows) noexcept override
+        {
+            batches.emplace_back(rows.size() / dimensions.width);
+            pixels.insert(pixels.end(), rows.begin(), rows.end());
+            return true;
+        }
+
+        bool end() noexcept override
+        {
+            ++endCalls;
+            return pixels.size() == dimensions.area();
+        }
+
+        bool beginResult{true};
+
+        std::uint32_t beginCalls{};
+
+        std::uint32_t endCalls{};
+
+        Rectangle dimensions{};
+
+        std::vector<size_t> batches{};
+
+        std::vector<BGRAPixel> pixels{};
+    };
+
+    class EndingTransformer : public IImageTransformer<BGRAPixel>
+    {
+    public:
+        Rectangle dimensions() const noexcept override { return Rectangle{width, height}; }
+
+        bool transform(BGRAPixel &) noexcept override { return ++transformed < (width + 2U); }
+
+        bool skip() noexcept override { return true; }
+
+        bool reset() noexcept override { return true; }
+
+        bool nextImage() noexcept override { return false; }
+
+        std::uint32_t transformed{};
+    };
+
+    void SetUp() noexcept override
+    {
+        for (auto i = 0U; i < imageBuffer.size(); ++i)
+        {
+            imageBuffer[i].blue = static_cast<std::uint8_t>(i);
+        }
+    }
+
+    static constexpr std::uint32_t const width{6};
+    static constexpr std::uint32_t const height{7};
+
+    std::array<BGRAPixel, width * height> imageBuffer{};
+
+    ImageView<BGRAPixel> view{imageBuffer.data(), Rectangle{width, height}, Rectangle{width, height}};
+
+    TestWriter writer{};
+};
+
+TEST_F(CommonIImageStreamWriter, TransformedImageIsWrittenInBatches)
+{
+    EXPECT_TRUE(writeTransformed(view, writer, 3U));
+    EXPECT_EQ(writer.beginCalls, 1U);
+    EXPECT_EQ(writer.endCalls, 1U);
+    EXPECT_EQ(writer.dimensions, (Rectangle{width, height}));
+    EXPECT_EQ(writer.batches, (std::vector<size_t>{3U, 3U, 1U}));
+    ASSERT_EQ(writer.pixels.size(), imageBuffer.size());
+    for (auto i = 0U; i < imageBuffer.size(); ++i)
+    {
+        EXPECT_EQ(writer.pixels[i], imageBuffer[i]);
+    }
+}
+
+TEST_F(CommonIImageStreamWriter, ConsumedTransformerIsReset)
+{
+    EXPECT_TRUE(writeTransformed(view, writer, 4U));
+
+    TestWriter second{};
+    EXPECT_TRUE(writeTransformed(view, second, 4U));
+    EXPECT_EQ(second.pixels, writer.pixels);
+}
+
+TEST_F(CommonIImageStreamWriter, WritingStopsIfTheTransformerEndsEarly)
+{
+    EndingTransformer transformer{};
+    EXPECT_FALSE(writeTransformed(transformer, writer, 1U));
+    EXPECT_EQ(writer.endCalls, 1U);
+    EXPECT_EQ(writer.batches.size(), 1U);
+}
+
+TEST_F(CommonIImageStreamWriter, EndIsCalledIfBeginFails)
+{
+    writer.beginResult = false;
+    EXPECT_FALSE(writeTransformed(view, writer));
+    EXPECT_EQ(writer.endCalls, 1U);
+    EXPECT_TRUE(writer.batches.empty());
+}
+
+TEST_F(CommonIImageStreamWriter, ZeroRowsPerBatchFails)
+{
+    EXPECT_FALSE(writeTransformed(view, writer, 0U));
+    EXPECT_EQ(writer.beginCalls, 0U);
+}
+
+TEST_F(CommonIImageStreamWriter, EmptyTransformerFails)
+{
+    ImageView<BGRAPixel> empty{};
+    EXPECT_FALSE(writeTransformed(empty, writer));
+    EXPECT_EQ(writer.beginCalls, 0U);
+    EXPECT_EQ(writer.endCalls, 0U);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,141 @@
+#include "THzImage/common/indexedImage.hpp"
+
+#include "THzCommon/math/rectangle.hpp"
+#include "THzImage/common/image.hpp"
+#include "THzImage/common/pixel.hpp"
+#include "THzImage/io/testImageGenerator.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct CommonIndexedImage : public testing::Test
+{
+    BGRAImage createImage() noexcept
+    {
+        std::array<BGRAPixel, 5U> const colors{BGRAPixel{0xFFU, 0U, 0U},
+                                               BGRAPixel{0U, 0xFFU, 0U},
+                                               BGRAPixel{0U, 0U, 0xFFU},
+                                               BGRAPixel{0x40U, 0x80U, 0xC0U},
+                                               BGRAPixel{0x40U, 0x80U, 0xC0U, 0U}};
+        BGRAImage                       image{};
+        (void)image.setDimensions(Rectangle{20U, 10U});
+        for (auto i = 0U; i < image.dimensions().area(); ++i)
+        {
+            image[i] = colors[(i / 3U) % colors.size()];
+        }
+        return image;
+    }
+
+    IndexedImage sut{};
+};
+
+TEST_F(CommonIndexedImage, ConstructionCorrect)
+{
+    EXPECT_EQ(sut.dimensions(), Rectangle{});
+    EXPECT_TRUE(sut.palette().empty());
+    EXPECT_TRUE(sut.indices().empty());
+}
+
+TEST_F(CommonIndexedImage, SetDimensionsAndPalette)
+{
+    ASSERT_TRUE(sut.setDimensions(Rectangle{4U, 3U}));
+    EXPECT_EQ(sut.dimensions(), (Rectangle{4U, 3U}));
+    EXPECT_EQ(sut.indices().size(), 12U);
+
+    std::vector<BGRAPixel> palette(IndexedImage::MaxColors + 1U);
+    EXPECT_FALSE(sut.setPalette(palette));
+    EXPECT_TRUE(sut.palette().empty());
+    palette.resize(IndexedImage::MaxColors);
+    EXPECT_TRUE(sut.setPalette(palette));
+    EXPECT_EQ(sut.palette().size(), IndexedImage::MaxColors);
+}
+
+TEST_F(CommonIndexedImage, ConvertingEmptyImageFails)
+{
+    BGRAImage image{};
+    EXPECT_FALSE(sut.convertFrom(image));
+}
+
+TEST_F(CommonIndexedImage, ConversionKeepsFewColorsIntact)
+{
+    auto const image = createImage();
+    ASSERT_TRUE(sut.convertFrom(image));
+    EXPECT_EQ(sut.dimensions(), image.dimensions());
+    // the transparent pixels share their color with other pixels, the transparent color is added at the end
+    ASSERT_EQ(sut.palette().size(), 5U);
+    EXPECT_EQ(sut.palette().back(), (BGRAPixel{0U, 0U, 0U, 0U}));
+
+    BGRAImage expanded{};
+    ASSERT_TRUE(sut.expandInto(expanded));
+    for (auto const i : image.dimensions().range())
+    {
+        EXPECT_EQ(expanded[i], image[i].alpha == 0U ? sut.palette().back() : image[i]);
+    }
+
+    IndexedImage dithered{};
+    ASSERT_TRUE(dithered.convertFrom(image, true));
+    EXPECT_EQ(dithered, sut);
+}
+
+TEST_F(CommonIndexedImage, ConversionResultCloseToOriginal)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{64U, 64U}};
+    ASSERT_TRUE(image.readFrom(generator));
+    ASSERT_TRUE(sut.convertFrom(image));
+    EXPECT_LE(sut.palette().size(), 255U);
+
+    BGRAImage expanded{};
+    ASSERT_TRUE(sut.expandInto(expanded));
+    auto accumulatedDeviations = 0.0;
+    for (auto const i : image.dimensions().range())
+    {
+        accumulatedDeviations += image[i].distanceSquared(expanded[i]);
+    }
+    accumulatedDeviations /= image.dimensions().area();
+    EXPECT_LT(accumulatedDeviations, 300.0);
+}
+
+TEST_F(CommonIndexedImage, ExactConversionResultCloserToOriginal)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{64U, 64U}};
+    ASSERT_TRUE(image.readFrom(generator));
+    IndexedImage exact{};
+    ASSERT_TRUE(sut.convertFrom(image));
+    ASSERT_TRUE(exact.convertFrom(image, false, true));
+    EXPECT_EQ(exact.palette().size(), sut.palette().size());
+
+    auto const colorError = [&image](IndexedImage const &indexed) noexcept {
+        BGRAImage expanded{};
+        EXPECT_TRUE(indexed.expandInto(expanded));
+        auto accumulatedDeviations = 0.0;
+        for (auto const i : image.dimensions().range())
+        {
+            accumulatedDeviations += image[i].distanceSquared(expanded[i]);
+        }
+        return accumulatedDeviations / image.dimensions().area();
+    };
+    EXPECT_LT(colorError(exact), colorError(sut));
+}
+
+TEST_F(CommonIndexedImage, IndicesOutsideOfThePaletteExpandToTransparent)
+{
+    std::array<BGRAPixel, 2U> const palette{BGRAPixel{1U, 2U, 3U}, BGRAPixel{4U, 5U, 6U}};
+    ASSERT_TRUE(sut.setDimensions(Rectangle{3U, 1U}));
+    ASSERT_TRUE(sut.setPalette(palette));
+    sut[0U] = 1U;
+    sut[1U] = 0U;
+    sut[2U] = 7U;
+
+    BGRAImage expanded{};
+    ASSERT_TRUE(sut.expandInto(expanded));
+    EXPECT_EQ(expanded[0U], palette[1U]);
+    EXPECT_EQ(expanded[1U], palette[0U]);
+    EXPECT_EQ(expanded[2U], (BGRAPixel{0U, 0U, 0U, 0U}));
+}
+
+} // namespace Terrahertz::UnitTests
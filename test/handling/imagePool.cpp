@@ -0,0 +1,87 @@
+#include "THzImage/handling/imagePool.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Terrahertz::UnitTests {
+
+struct HandlingImagePool : public testing::Test
+{
+    ImagePool<BGRAPixel> sut{2U};
+};
+
+TEST_F(HandlingImagePool, AcquireCreatesNewImageIfPoolIsEmpty)
+{
+    EXPECT_EQ(sut.idleImages(), 0U);
+    auto const image = sut.acquire();
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->dimensions(), Rectangle{});
+    EXPECT_EQ(sut.idleImages(), 0U);
+}
+
+TEST_F(HandlingImagePool, PublishingNullptrResultsInEmptyHandle)
+{
+    auto const shared = sut.publish(nullptr);
+    EXPECT_FALSE(shared);
+    EXPECT_EQ(shared.get(), nullptr);
+}
+
+TEST_F(HandlingImagePool, ReleasedImageIsReturnedToThePool)
+{
+    auto image = sut.acquire();
+    ASSERT_TRUE(image->setDimensions(Rectangle{4U, 2U}));
+    auto const *address = image.get();
+
+    auto shared = sut.publish(std::move(image));
+    EXPECT_TRUE(shared);
+    EXPECT_EQ(shared.get(), address);
+    EXPECT_EQ(shared.useCount(), 1U);
+
+    auto copy = shared;
+    EXPECT_EQ(copy, shared);
+    EXPECT_EQ(shared.useCount(), 2U);
+    shared.reset();
+    EXPECT_EQ(sut.idleImages(), 0U);
+    copy.reset();
+    EXPECT_EQ(sut.idleImages(), 1U);
+
+    auto const reused = sut.acquire();
+    EXPECT_EQ(reused.get(), address);
+    EXPECT_EQ(reused->dimensions(), (Rectangle{4U, 2U}));
+    EXPECT_EQ(sut.idleImages(), 0U);
+}
+
+TEST_F(HandlingImagePool, IdleImagesAreLimited)
+{
+    auto shared0 = sut.publish(sut.acquire());
+    auto shared1 = sut.publish(sut.acquire());
+    auto shared2 = sut.publish(sut.acquire());
+    shared0.reset();
+    shared1.reset();
+    shared2.reset();
+    EXPECT_EQ(sut.idleImages(), 2U);
+}
+
+TEST_F(HandlingImagePool, HandlesOutliveThePool)
+{
+    SharedImage<BGRAPixel> shared{};
+    {
+        ImagePool<BGRAPixel> pool{};
+        auto                 image = pool.acquire();
+        ASSERT_TRUE(image->setDimensions(Rectangle{2U, 2U}));
+        shared = pool.publish(std::move(image));
+    }
+    ASSERT_TRUE(shared);
+    EXPECT_EQ(shared->dimensions(), (Rectangle{2U, 2U}));
+    shared.reset();
+}
+
+TEST_F(HandlingImagePool, BorrowedImageIsNotOwned)
+{
+    BGRAImage image{};
+    auto      shared = SharedImage<BGRAPixel>::borrow(image);
+    EXPECT_TRUE(shared);
+    EXPECT_EQ(shared.get(), &image);
+    EXPECT_EQ(shared.useCount(), 0U);
+}
+
+} // namespace Terrahertz::UnitTests
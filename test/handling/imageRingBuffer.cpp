@@ -230,4 +230,21 @@ TEST_F(HandlingImageRingBuffer, NextCountsFailureIfRequested)
     EXPECT_EQ(sut.count(), 4U);
 }
 
+TEST_F(HandlingImageRingBuffer, SharedImageOutlivesSlot)
+{
+    EXPECT_TRUE(sut.next());
+    auto const shared = sut.share(0U);
+    EXPECT_EQ(shared.get(), &sut[0U]);
+    EXPECT_EQ(shared.useCount(), 2U);
+
+    EXPECT_TRUE(sut.next());
+    EXPECT_TRUE(sut.next());
+    EXPECT_TRUE(sut.next());
+    checkImage(*shared, reader.value - 3U);
+    EXPECT_NE(shared.get(), &sut[0U]);
+    EXPECT_NE(shared.get(), &sut[1U]);
+    EXPECT_NE(shared.get(), &sut[2U]);
+    EXPECT_EQ(shared.useCount(), 1U);
+}
+
 } // namespace Terrahertz::UnitTests
@@ -4,8 +4,10 @@
 #include "THzImage/common/image.hpp"
 #include "THzImage/common/pixel.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <gtest/gtest.h>
+#include <memory>
 #include <thread>
 
 // As long as these tests do not fail in release everything is fine
@@ -26,6 +28,7 @@ struct IOAsyncWriter : public testing::Test
         bool write(Rectangle const &dimensions, gsl::span<BGRAPixel const> const buffer) noexcept override
         {
             std::this_thread::sleep_for(std::chrono::milliseconds{16U});
+            ++written;
             return true;
         }
 
@@ -34,9 +37,15 @@ struct IOAsyncWriter : public testing::Test
         bool initCalled{};
 
         bool writeFinished{};
+
+        std::atomic_size_t written{};
     };
 
+    void SetUp() override { ASSERT_TRUE(image.setDimensions(Rectangle{2U, 2U})); }
+
     MockWriter writer{};
+
+    BGRAImage image{};
 };
 
 TEST_F(IOAsyncWriter, GeneralOperation)
@@ -72,6 +81,101 @@ TEST_F(IOAsyncWriter, GeneralOperation)
     EXPECT_FALSE(sut.write(image));
 }
 
+TEST_F(IOAsyncWriter, QueueAcceptsImagesUpToItsDepth)
+{
+    AsyncWriter<BGRAPixel> sut{writer, 3U};
+    EXPECT_TRUE(sut.write(image));
+    EXPECT_TRUE(sut.write(image));
+    EXPECT_TRUE(sut.write(image));
+    EXPECT_FALSE(sut.write(image));
+    EXPECT_EQ(sut.pending(), 3U);
+
+    sut.flush();
+    EXPECT_EQ(sut.pending(), 0U);
+    EXPECT_EQ(writer.written, 3U);
+}
+
+TEST_F(IOAsyncWriter, BlockingWaitsForRoomInTheQueue)
+{
+    using TestSubject = AsyncWriter<BGRAPixel>;
+    TestSubject sut{writer, 1U, TestSubject::Backpressure::block};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        EXPECT_TRUE(sut.write(image));
+    }
+    sut.flush();
+    EXPECT_EQ(writer.written, 4U);
+}
+
+TEST_F(IOAsyncWriter, DropOldestDropsQueuedImage)
+{
+    using TestSubject = AsyncWriter<BGRAPixel>;
+    TestSubject        sut{writer, 2U, TestSubject::Backpressure::dropOldest};
+    std::atomic_size_t succeeded{};
+    std::atomic_size_t failed{};
+    auto const         callback = [&](bool const written) { ++(written ? succeeded : failed); };
+
+    EXPECT_TRUE(sut.write(image, callback));
+    std::this_thread::sleep_for(std::chrono::milliseconds{4U});
+    EXPECT_TRUE(sut.write(image, callback));
+    EXPECT_TRUE(sut.write(image, callback));
+    EXPECT_EQ(failed, 1U);
+
+    sut.flush();
+    EXPECT_EQ(succeeded, 2U);
+    EXPECT_EQ(writer.written, 2U);
+}
+
+TEST_F(IOAsyncWriter, SubmitProvidesResultAsFuture)
+{
+    AsyncWriter<BGRAPixel> sut{writer, 1U};
+    auto                   shared   = SharedImage<BGRAPixel>::copyOf(image);
+    auto                   accepted = sut.submit(shared);
+    auto                   rejected = sut.submit(shared);
+    shared.reset();
+    EXPECT_FALSE(rejected.get());
+    EXPECT_TRUE(accepted.get());
+}
+
+TEST_F(IOAsyncWriter, MultipleWorkersWriteInParallel)
+{
+    std::atomic_size_t created{};
+    auto const         factory = [&]() -> std::unique_ptr<IImageWriter<BGRAPixel>> {
+        ++created;
+        return std::make_unique<MockWriter>();
+    };
+
+    using TestSubject = AsyncWriter<BGRAPixel>;
+    std::atomic_size_t succeeded{};
+    {
+        TestSubject sut{factory, 4U, 4U};
+        EXPECT_EQ(created, 4U);
+        for (auto i = 0U; i < 8U; ++i)
+        {
+            EXPECT_TRUE(sut.write(image, [&](bool const written) { succeeded += written ? 1U : 0U; }));
+        }
+    }
+    EXPECT_EQ(succeeded, 8U);
+}
+
+TEST_F(IOAsyncWriter, WriterIsPreparedBeforeWriting)
+{
+    std::atomic_bool preparedBeforeInit{};
+    std::atomic_bool preparedOnWorker{};
+    auto const       caller = std::this_thread::get_id();
+    {
+        AsyncWriter<BGRAPixel> sut{writer, 1U};
+        auto const             prepare = [&](IImageWriter<BGRAPixel> &prepared) noexcept {
+            preparedBeforeInit = (&prepared == &writer) && !writer.initCalled;
+            preparedOnWorker   = std::this_thread::get_id() != caller;
+        };
+        EXPECT_TRUE(sut.write(SharedImage<BGRAPixel>::copyOf(image), prepare, {}));
+    }
+    EXPECT_TRUE(preparedBeforeInit);
+    EXPECT_TRUE(preparedOnWorker);
+    EXPECT_EQ(writer.written, 1U);
+}
+
 } // namespace Terrahertz::UnitTests
 
 #endif // !NDEBUG
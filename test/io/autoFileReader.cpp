@@ -2,10 +2,17 @@
 
 #include "THzImage/common/image.hpp"
 #include "THzImage/io/bmpWriter.hpp"
+#include "THzImage/io/frameWriter.hpp"
+#include "THzImage/io/gifReader.hpp"
+#include "THzImage/io/gifWriter.hpp"
 #include "THzImage/io/pngWriter.hpp"
 #include "THzImage/io/qoiWriter.hpp"
 #include "THzImage/io/testImageGenerator.hpp"
 
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
 namespace Terrahertz::UnitTests {
@@ -70,6 +77,53 @@ TEST_F(IOAutoFileReader, ReadQOIStrict)
     EXPECT_FALSE(sut.imagePresent());
 }
 
+TEST_F(IOAutoFileReader, ReadFrameStrict)
+{
+    Frame::Writer<BGRAPixel> writer{"autoTest.thzf"};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+
+    BGRAImage        image{};
+    AutoFile::Reader sut{"autoTest.thzf", AutoFile::Reader::ExtensionMode::strict};
+    EXPECT_TRUE(sut.imagePresent());
+    EXPECT_TRUE(sut.readInto(image));
+    EXPECT_EQ(testImage, image);
+    EXPECT_FALSE(sut.imagePresent());
+}
+
+TEST_F(IOAutoFileReader, ReadGIFStrict)
+{
+    GIF::Writer writer{"autoTest.gif"};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+
+    // the color reduction is lossy, so the result of the GIF::Reader is expected
+    BGRAImage   expected{};
+    GIF::Reader reader{"autoTest.gif"};
+    ASSERT_TRUE(expected.readFrom(reader));
+
+    BGRAImage        image{};
+    AutoFile::Reader sut{"autoTest.gif", AutoFile::Reader::ExtensionMode::strict};
+    EXPECT_TRUE(sut.imagePresent());
+    EXPECT_TRUE(sut.readInto(image));
+    EXPECT_EQ(expected, image);
+    EXPECT_FALSE(sut.imagePresent());
+}
+
+TEST_F(IOAutoFileReader, LenientOnFrameWithOtherPixelType)
+{
+    Image<MiniHSVPixel> miniImage{};
+    ASSERT_TRUE(miniImage.convertAndStore(testImage));
+    Frame::Writer<MiniHSVPixel> writer{"undercoverFrame.png"};
+    ASSERT_TRUE(miniImage.writeTo(&writer));
+
+    BGRAImage expected{};
+    ASSERT_TRUE(expected.convertAndStore(miniImage));
+
+    BGRAImage        image{};
+    AutoFile::Reader sut{"undercoverFrame.png"};
+    EXPECT_TRUE(sut.readInto(image));
+    EXPECT_EQ(expected, image);
+}
+
 TEST_F(IOAutoFileReader, StrictModeFailure)
 {
     QOI::Writer writer{"undercoverQOI.bmp"};
@@ -108,6 +162,38 @@ TEST_F(IOAutoFileReader, LenientOnUnknownExtension)
     EXPECT_FALSE(sut.imagePresent());
 }
 
+TEST_F(IOAutoFileReader, LenientOnGIFWithOtherExtension)
+{
+    GIF::Writer writer{"undercoverGIF.qoi"};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+
+    BGRAImage   expected{};
+    GIF::Reader reader{"undercoverGIF.qoi"};
+    ASSERT_TRUE(expected.readFrom(reader));
+
+    BGRAImage        image{};
+    AutoFile::Reader sut{"undercoverGIF.qoi"};
+    EXPECT_TRUE(sut.readInto(image));
+    EXPECT_EQ(expected, image);
+}
+
+TEST_F(IOAutoFileReader, UnknownContentFails)
+{
+    {
+        std::ofstream stream{"unknownContent.png", std::ios::binary};
+        stream << "neither of the supported formats";
+    }
+
+    BGRAImage        image{};
+    AutoFile::Reader sut{"unknownContent.png"};
+    EXPECT_TRUE(sut.imagePresent());
+    EXPECT_FALSE(sut.readInto(image));
+    EXPECT_FALSE(sut.imagePresent());
+
+    sut.reset("nonExisting.png");
+    EXPECT_FALSE(sut.readInto(image));
+}
+
 TEST_F(IOAutoFileReader, Reset)
 {
     QOI::Writer qoiWriter{"autoSeries.qoi"};
@@ -162,6 +248,115 @@ TEST_F(IOAutoFileReader, ExtensionSupported)
     EXPECT_TRUE(sut.extensionSupported());
     sut.reset("image.qoi");
     EXPECT_TRUE(sut.extensionSupported());
+    sut.reset("image.gif");
+    EXPECT_TRUE(sut.extensionSupported());
+    sut.reset("image.thzf");
+    EXPECT_TRUE(sut.extensionSupported());
+}
+
+struct IOAutoFileProbe : public testing::Test
+{
+    void SetUp() noexcept override
+    {
+        TestImageGenerator generator{Rectangle{24U, 16U}};
+        (void)testImage.readFrom(generator);
+    }
+
+    BGRAImage testImage{};
+};
+
+TEST_F(IOAutoFileProbe, UnsupportedFilesHaveNoInfo)
+{
+    {
+        std::ofstream stream{"probeUnknown.png", std::ios::binary};
+        stream << "neither of the supported formats";
+    }
+    EXPECT_FALSE(AutoFile::probe("probeUnknown.png"));
+    EXPECT_FALSE(AutoFile::probe("nonExisting.png"));
+}
+
+TEST_F(IOAutoFileProbe, ProbingEachFormat)
+{
+    BMP::Writer              bmpWriter{"probe.bmp", false};
+    Frame::Writer<BGRAPixel> frameWriter{"probe.thzf"};
+    GIF::Writer              gifWriter{"probe.gif"};
+    PNG::Writer              pngWriter{"probe.png"};
+    QOI::Writer              qoiWriter{"probe.qoi"};
+    ASSERT_TRUE(testImage.writeTo(&bmpWriter));
+    ASSERT_TRUE(testImage.writeTo(&frameWriter));
+    ASSERT_TRUE(testImage.writeTo(&gifWriter));
+    ASSERT_TRUE(testImage.writeTo(&pngWriter));
+    ASSERT_TRUE(testImage.writeTo(&qoiWriter));
+
+    struct Expectation
+    {
+        char const *path;
+
+        AutoFile::FileFormat format;
+
+        std::uint32_t bitsPerPixel;
+    };
+    std::array<Expectation, 5U> const expectations{Expectation{"probe.bmp", AutoFile::FileFormat::BMP, 24U},
+                                                   Expectation{"probe.thzf", AutoFile::FileFormat::Frame, 32U},
+                                                   Expectation{"probe.gif", AutoFile::FileFormat::GIF, 8U},
+                                                   Expectation{"probe.png", AutoFile::FileFormat::PNG, 32U},
+                                                   Expectation{"probe.qoi", AutoFile::FileFormat::QOI, 32U}};
+    for (auto const &expectation : expectations)
+    {
+        auto const info = AutoFile::probe(expectation.path);
+        ASSERT_TRUE(info) << expectation.path;
+        EXPECT_EQ(info->format, expectation.format) << expectation.path;
+        EXPECT_EQ(info->dimensions, testImage.dimensions()) << expectation.path;
+        EXPECT_EQ(info->bitsPerPixel, expectation.bitsPerPixel) << expectation.path;
+        EXPECT_EQ(info->frameCount, 1U) << expectation.path;
+    }
+}
+
+TEST_F(IOAutoFileProbe, FramesOfAnimationAreCounted)
+{
+    GIF::Writer writer{"probeAnimation.gif"};
+    ASSERT_TRUE(writer.beginAnimation());
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        testImage[i] = BGRAPixel{0xFFU, 0xFFU, 0xFFU};
+        ASSERT_TRUE(testImage.writeTo(&writer));
+    }
+    ASSERT_TRUE(writer.endAnimation());
+
+    auto const info = AutoFile::probe("probeAnimation.gif");
+    ASSERT_TRUE(info);
+    EXPECT_EQ(info->dimensions, testImage.dimensions());
+    EXPECT_EQ(info->frameCount, 3U);
+}
+
+TEST_F(IOAutoFileProbe, ProbingDirectory)
+{
+    std::filesystem::path const directory{"probeDirectory"};
+    std::filesystem::remove_all(directory);
+    ASSERT_TRUE(std::filesystem::create_directories(directory / "sub"));
+
+    PNG::Writer pngWriter{directory / "image.png"};
+    QOI::Writer qoiWriter{directory / "sub" / "image.qoi"};
+    ASSERT_TRUE(testImage.writeTo(&pngWriter));
+    ASSERT_TRUE(testImage.writeTo(&qoiWriter));
+    {
+        std::ofstream stream{directory / "notes.txt"};
+        stream << "not an image";
+    }
+
+    auto files = AutoFile::probeDirectory(directory, 4U);
+    ASSERT_EQ(files.size(), 2U);
+    std::sort(files.begin(), files.end(), [](auto const &a, auto const &b) noexcept { return a.path < b.path; });
+    EXPECT_EQ(files[0U].path, directory / "image.png");
+    EXPECT_EQ(files[0U].info.format, AutoFile::FileFormat::PNG);
+    EXPECT_EQ(files[1U].path, directory / "sub" / "image.qoi");
+    EXPECT_EQ(files[1U].info.format, AutoFile::FileFormat::QOI);
+    for (auto const &file : files)
+    {
+        EXPECT_EQ(file.info.dimensions, testImage.dimensions());
+    }
+
+    EXPECT_TRUE(AutoFile::probeDirectory("nonExistingDirectory").empty());
 }
 
 } // namespace Terrahertz::UnitTests
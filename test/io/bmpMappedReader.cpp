@@ -0,0 +1,153 @@
+#include "THzImage/io/bmpMappedReader.hpp"
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/bmpWriter.hpp"
+
+#include <array>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace Terrahertz::UnitTests {
+
+struct IOBMPMappedReader : public testing::Test
+{
+    std::string filepath{"test.bmp"};
+
+    std::array<std::uint8_t, 70U> testFilecontent{
+        0x42U, 0x4DU, 0x46U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x36U, 0x00U, 0x00U, 0x00U,
+        0x28U, 0x00U, 0x00U, 0x00U, 0x02U, 0x00U, 0x00U, 0x00U, 0x02U, 0x00U, 0x00U, 0x00U, 0x01U, 0x00U,
+        0x20U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x10U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U,
+        0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U, 0x20U,
+        0x25U, 0x24U, 0x13U, 0x24U, 0x50U, 0x34U, 0x31U, 0x22U, 0x05U, 0x20U, 0x01U, 0x44U, 0xFFU, 0x17U};
+
+    void prepareTestFile(gsl::span<std::uint8_t const> buffer) noexcept
+    {
+        std::ofstream stream{filepath, std::ios::binary};
+        ASSERT_TRUE(stream.is_open());
+        stream.write(std::bit_cast<char const *>(buffer.data()), buffer.size());
+        stream.close();
+    }
+
+    void prepareTestFile() noexcept { prepareTestFile(testFilecontent); }
+
+    void setTopDown() noexcept { (*std::bit_cast<std::int32_t *>(&testFilecontent[22U])) = -2; }
+};
+
+TEST_F(IOBMPMappedReader, NonExistingFile)
+{
+    BMP::MappedReader sut{"notHere.bmp"};
+    EXPECT_FALSE(sut.imagePresent());
+    EXPECT_FALSE(sut.fileTypeFits());
+    EXPECT_FALSE(sut.init());
+    EXPECT_EQ(sut.view().dimensions(), Rectangle{});
+}
+
+TEST_F(IOBMPMappedReader, MagicBytesIncorrect)
+{
+    testFilecontent[0U] = 0x33U;
+    prepareTestFile();
+
+    BMP::MappedReader sut{filepath};
+    EXPECT_TRUE(sut.imagePresent());
+    EXPECT_FALSE(sut.fileTypeFits());
+    EXPECT_FALSE(sut.init());
+}
+
+TEST_F(IOBMPMappedReader, FileTooSmall)
+{
+    setTopDown();
+    prepareTestFile(toSpan<std::uint8_t>(testFilecontent).subspan(0U, 64U));
+
+    BMP::MappedReader sut{filepath};
+    EXPECT_TRUE(sut.fileTypeFits());
+    EXPECT_FALSE(sut.init());
+}
+
+TEST_F(IOBMPMappedReader, TopDownFileIsViewedWithoutCopying)
+{
+    setTopDown();
+    prepareTestFile();
+
+    BMP::MappedReader sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_TRUE(sut.zeroCopy());
+    EXPECT_EQ(sut.dimensions(), (Rectangle{2U, 2U}));
+
+    auto view = sut.view();
+    ASSERT_EQ(view.dimensions(), (Rectangle{2U, 2U}));
+    EXPECT_EQ(*view, (BGRAPixel{0x01U, 0x20U, 0x25U, 0x24U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x13U, 0x24U, 0x50U, 0x34U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x31U, 0x22U, 0x05U, 0x20U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x01U, 0x44U, 0xFFU, 0x17U}));
+}
+
+TEST_F(IOBMPMappedReader, BottomUpFileIsCopied)
+{
+    prepareTestFile();
+
+    BMP::MappedReader sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_FALSE(sut.zeroCopy());
+
+    auto view = sut.view();
+    ASSERT_EQ(view.dimensions(), (Rectangle{2U, 2U}));
+    EXPECT_EQ(*view, (BGRAPixel{0x31U, 0x22U, 0x05U, 0x20U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x01U, 0x44U, 0xFFU, 0x17U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x01U, 0x20U, 0x25U, 0x24U}));
+    ++view;
+    EXPECT_EQ(*view, (BGRAPixel{0x13U, 0x24U, 0x50U, 0x34U}));
+}
+
+TEST_F(IOBMPMappedReader, ReadingDataWithoutTransparency)
+{
+    BGRAImage expected{};
+    ASSERT_TRUE(expected.setDimensions(Rectangle{3U, 2U}));
+    for (auto i = 0U; i < 6U; ++i)
+    {
+        expected[i] = BGRAPixel{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 2U), 7U};
+    }
+
+    BMP::Writer writer{filepath, false};
+    ASSERT_TRUE(expected.writeTo(&writer));
+
+    BGRAImage         actual{};
+    BMP::MappedReader reader{filepath};
+    ASSERT_TRUE(actual.readFrom(reader));
+    EXPECT_FALSE(reader.imagePresent());
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(IOBMPMappedReader, ViewMatchesStreamedImage)
+{
+    BGRAImage expected{};
+    ASSERT_TRUE(expected.setDimensions(Rectangle{5U, 3U}));
+    for (auto i = 0U; i < 15U; ++i)
+    {
+        expected[i] = BGRAPixel{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 3U), 9U, 200U};
+    }
+
+    BMP::Writer writer{filepath};
+    ASSERT_TRUE(writer.begin(expected.dimensions()));
+    ASSERT_TRUE(writer.writeRows(gsl::span<BGRAPixel const>{&expected[0U], 15U}));
+    ASSERT_TRUE(writer.end());
+
+    BMP::MappedReader sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_TRUE(sut.zeroCopy());
+    auto view = sut.view();
+    ASSERT_EQ(view.dimensions(), expected.dimensions());
+    for (auto i = 0U; i < 15U; ++i, ++view)
+    {
+        EXPECT_EQ(*view, expected[i]);
+    }
+    sut.deinit();
+    EXPECT_FALSE(sut.imagePresent());
+    EXPECT_EQ(sut.view().dimensions(), Rectangle{});
+}
+
+} // namespace Terrahertz::UnitTests
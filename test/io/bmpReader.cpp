@@ -237,4 +237,41 @@ TEST_F(IOBMPReader, FileTooSmall)
     EXPECT_FALSE(image.readFrom(sut));
 }
 
+TEST_F(IOBMPReader, FileTooSmallTopDown)
+{
+    (*std::bit_cast<std::int32_t *>(&testFilecontent[22U])) = -2;
+    prepareTestFile(toSpan<std::uint8_t>(testFilecontent).subspan(0U, 64U));
+
+    BGRAImage   image{};
+    BMP::Reader sut{filepath};
+    EXPECT_FALSE(image.readFrom(sut));
+}
+
+TEST_F(IOBMPReader, ReadingDataWithoutTransparencySetsAlpha)
+{
+    BGRAImage expected{};
+    ASSERT_TRUE(expected.setDimensions(Rectangle{3U, 2U}));
+    for (auto i = 0U; i < 6U; ++i)
+    {
+        expected[i] = BGRAPixel{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 2U), 7U};
+    }
+
+    BMP::Writer writer{filepath, false};
+    ASSERT_TRUE(expected.writeTo(&writer));
+
+    std::array<BGRAPixel, 6U> actual{};
+    for (auto &pixel : actual)
+    {
+        pixel.alpha = 0U;
+    }
+    BMP::Reader reader{filepath};
+    ASSERT_TRUE(reader.init());
+    ASSERT_TRUE(reader.read(actual));
+    reader.deinit();
+    for (auto i = 0U; i < 6U; ++i)
+    {
+        EXPECT_EQ(expected[i], actual[i]);
+    }
+}
+
 } // namespace Terrahertz::UnitTests
@@ -3,6 +3,7 @@
 #include "THzCommon/math/rectangle.hpp"
 #include "THzCommon/utility/fstreamhelpers.hpp"
 #include "THzCommon/utility/spanhelpers.hpp"
+#include "THzImage/io/bmpReader.hpp"
 
 #include <array>
 #include <fstream>
@@ -126,4 +127,57 @@ TEST_F(IOBMPWriter, WritingWithoutTransparencyPadding)
     }
 }
 
+TEST_F(IOBMPWriter, WritingRowByRow)
+{
+    Rectangle const dimensions{3U, 4U};
+
+    std::array<BGRAPixel, 12U> imageData{};
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(i), 0x10U, static_cast<std::uint8_t>(i * 3U), 0xFFU};
+    }
+    auto const data = toSpan<BGRAPixel const>(imageData);
+
+    for (auto const transparency : {true, false})
+    {
+        BMP::Writer sut{filepath, transparency};
+        EXPECT_FALSE(sut.writeRows(data.subspan(0U, 3U)));
+        EXPECT_TRUE(sut.begin(dimensions));
+        EXPECT_FALSE(sut.writeRows(data.subspan(0U, 4U)));
+        EXPECT_TRUE(sut.writeRows(data.subspan(0U, 3U)));
+        EXPECT_TRUE(sut.writeRows(data.subspan(3U)));
+        EXPECT_TRUE(sut.end());
+
+        std::array<BGRAPixel, 12U> loadedData{};
+
+        BMP::Reader reader{filepath};
+        EXPECT_TRUE(reader.init());
+        EXPECT_EQ(reader.dimensions(), dimensions);
+        EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+        reader.deinit();
+        EXPECT_EQ(loadedData, imageData);
+    }
+}
+
+TEST_F(IOBMPWriter, PaddingStaysZeroWhenReusingTheWriter)
+{
+    BMP::Writer sut{filepath, false};
+
+    std::array<BGRAPixel, 4U> wideData{};
+    wideData.fill(BGRAPixel{0xAAU, 0xBBU, 0xCCU});
+    EXPECT_TRUE(sut.write(Rectangle{4U, 1U}, toSpan<BGRAPixel const>(wideData)));
+
+    std::array<BGRAPixel, 2U> narrowData{};
+    EXPECT_TRUE(sut.write(Rectangle{2U, 1U}, toSpan<BGRAPixel const>(narrowData)));
+
+    std::ifstream file{filepath, std::ios::binary};
+    ASSERT_TRUE(file.is_open());
+    std::array<std::uint8_t, 128U> buffer{};
+    ASSERT_EQ(readFromStream(file, buffer), 62U);
+    for (auto i = 54U; i < 62U; ++i)
+    {
+        EXPECT_EQ(buffer[i], 0U) << "idx: " << i;
+    }
+}
+
 } // namespace Terrahertz::UnitTests
@@ -0,0 +1,166 @@
+#include "THzImage/io/frameReader.hpp"
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/frameWriter.hpp"
+#include "THzImage/io/testImageGenerator.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct IOFrameReader : public testing::Test
+{
+    void SetUp() noexcept override
+    {
+        TestImageGenerator generator{Rectangle{12U, 7U}};
+        ASSERT_TRUE(testImage.readFrom(generator));
+    }
+
+    void corruptByte(size_t const offset) noexcept
+    {
+        std::fstream stream{filepath, std::ios::binary | std::ios::in | std::ios::out};
+        ASSERT_TRUE(stream.is_open());
+        stream.seekp(offset);
+        stream.put(0x7F);
+    }
+
+    std::string filepath{"test.thzf"};
+
+    BGRAImage testImage{};
+};
+
+TEST_F(IOFrameReader, NonExistingFile)
+{
+    Frame::Reader<BGRAPixel> sut{"notHere.thzf"};
+    EXPECT_FALSE(sut.imagePresent());
+    EXPECT_FALSE(sut.fileTypeFits());
+    EXPECT_FALSE(sut.init());
+    EXPECT_EQ(sut.view().dimensions(), Rectangle{});
+}
+
+TEST_F(IOFrameReader, ReadingSamePixelTypeIsZeroCopy)
+{
+    Frame::Writer<BGRAPixel> writer{filepath};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+
+    Frame::Reader<BGRAPixel> sut{filepath};
+    EXPECT_TRUE(sut.fileTypeFits());
+    ASSERT_TRUE(sut.init());
+    EXPECT_EQ(sut.pixelTag(), Frame::PixelTag::bgra);
+    EXPECT_TRUE(sut.zeroCopy());
+    EXPECT_EQ(sut.dimensions(), testImage.dimensions());
+
+    auto view = sut.view();
+    ASSERT_EQ(view.dimensions(), testImage.dimensions());
+    for (auto i = 0U; i < testImage.dimensions().area(); ++i, ++view)
+    {
+        EXPECT_EQ(*view, testImage[i]);
+    }
+    sut.deinit();
+    EXPECT_FALSE(sut.imagePresent());
+
+    BGRAImage                image{};
+    Frame::Reader<BGRAPixel> reader{filepath};
+    EXPECT_TRUE(image.readFrom(reader));
+    EXPECT_EQ(image, testImage);
+}
+
+TEST_F(IOFrameReader, HSVAPixelRoundTrip)
+{
+    Image<HSVAPixel> expected{};
+    ASSERT_TRUE(expected.convertAndStore(testImage));
+    Frame::Writer<HSVAPixel> writer{filepath};
+    ASSERT_TRUE(expected.writeTo(&writer));
+
+    Image<HSVAPixel>         image{};
+    Frame::Reader<HSVAPixel> sut{filepath};
+    EXPECT_TRUE(image.readFrom(sut));
+    EXPECT_EQ(image, expected);
+}
+
+TEST_F(IOFrameReader, OtherPixelTypeIsConverted)
+{
+    Image<MiniHSVPixel> stored{};
+    ASSERT_TRUE(stored.convertAndStore(testImage));
+    Frame::Writer<MiniHSVPixel> writer{filepath};
+    ASSERT_TRUE(stored.writeTo(&writer));
+
+    BGRAImage expected{};
+    ASSERT_TRUE(expected.convertAndStore(stored));
+
+    Frame::Reader<BGRAPixel> sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_EQ(sut.pixelTag(), Frame::PixelTag::miniHSV);
+    EXPECT_FALSE(sut.zeroCopy());
+    auto view = sut.view();
+    ASSERT_EQ(view.dimensions(), expected.dimensions());
+    for (auto i = 0U; i < expected.dimensions().area(); ++i, ++view)
+    {
+        EXPECT_EQ(*view, expected[i]);
+    }
+}
+
+TEST_F(IOFrameReader, HSVPixelTypesAreConvertedDirectly)
+{
+    Image<HSVAPixel> hsva{};
+    ASSERT_TRUE(hsva.convertAndStore(testImage));
+    Frame::Writer<HSVAPixel> hsvaWriter{filepath};
+    ASSERT_TRUE(hsva.writeTo(&hsvaWriter));
+
+    Image<MiniHSVPixel> expectedMini{};
+    ASSERT_TRUE(expectedMini.convertAndStore(hsva));
+    Image<MiniHSVPixel>         mini{};
+    Frame::Reader<MiniHSVPixel> miniReader{filepath};
+    ASSERT_TRUE(mini.readFrom(miniReader));
+    EXPECT_EQ(mini, expectedMini);
+
+    Frame::Writer<MiniHSVPixel> miniWriter{filepath};
+    ASSERT_TRUE(mini.writeTo(&miniWriter));
+    Image<HSVAPixel>         read{};
+    Frame::Reader<HSVAPixel> hsvaReader{filepath};
+    ASSERT_TRUE(read.readFrom(hsvaReader));
+    ASSERT_EQ(read.dimensions(), mini.dimensions());
+    for (auto i = 0U; i < mini.dimensions().area(); ++i)
+    {
+        EXPECT_EQ(read[i], static_cast<HSVAPixel>(mini[i]));
+    }
+}
+
+TEST_F(IOFrameReader, CorruptedDataFailsChecksum)
+{
+    Frame::Writer<BGRAPixel> writer{filepath};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+    corruptByte(Frame::Header::DataAlignment + 5U);
+
+    Frame::Reader<BGRAPixel> sut{filepath};
+    EXPECT_FALSE(sut.init());
+
+    Frame::Reader<BGRAPixel> unchecked{filepath, false};
+    EXPECT_TRUE(unchecked.init());
+}
+
+TEST_F(IOFrameReader, CorruptedHeaderFails)
+{
+    Frame::Writer<BGRAPixel> writer{filepath};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+    // pixel tag
+    corruptByte(5U);
+
+    Frame::Reader<BGRAPixel> sut{filepath};
+    EXPECT_TRUE(sut.fileTypeFits());
+    EXPECT_FALSE(sut.init());
+}
+
+TEST_F(IOFrameReader, FileTooSmall)
+{
+    Frame::Writer<BGRAPixel> writer{filepath};
+    ASSERT_TRUE(testImage.writeTo(&writer));
+    std::filesystem::resize_file(filepath, std::filesystem::file_size(filepath) - 1U);
+
+    Frame::Reader<BGRAPixel> sut{filepath, false};
+    EXPECT_FALSE(sut.init());
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,77 @@
+#include "THzImage/io/frameWriter.hpp"
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/frameFormat.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct IOFrameWriter : public testing::Test
+{
+    std::string filepath{"test.thzf"};
+
+    std::vector<std::uint8_t> readFile() noexcept
+    {
+        std::ifstream             stream{filepath, std::ios::binary};
+        std::vector<std::uint8_t> content{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+        return content;
+    }
+};
+
+TEST_F(IOFrameWriter, EmptyImageIsNotWritten)
+{
+    std::array<BGRAPixel, 1U> buffer{};
+
+    Frame::Writer<BGRAPixel> sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_FALSE(sut.write(Rectangle{0U, 0U}, buffer));
+    EXPECT_FALSE(sut.write(Rectangle{2U, 2U}, buffer));
+    sut.deinit();
+}
+
+TEST_F(IOFrameWriter, FileLayout)
+{
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{3U, 2U}));
+    for (auto i = 0U; i < 6U; ++i)
+    {
+        image[i] = BGRAPixel{static_cast<std::uint8_t>(i), 2U, 3U, 4U};
+    }
+    Frame::Writer<BGRAPixel> sut{filepath};
+    ASSERT_TRUE(image.writeTo(&sut));
+
+    auto const content = readFile();
+    ASSERT_EQ(content.size(), Frame::Header::DataAlignment + 6U * sizeof(BGRAPixel));
+
+    Frame::Header header{};
+    std::memcpy(&header, content.data(), sizeof(Frame::Header));
+    EXPECT_EQ(header.magic, Frame::Header::MagicBytes);
+    EXPECT_EQ(header.version, Frame::Header::CurrentVersion);
+    EXPECT_EQ(header.pixelTag, Frame::PixelTag::bgra);
+    EXPECT_EQ(header.pixelSize, sizeof(BGRAPixel));
+    EXPECT_EQ(header.width, 3U);
+    EXPECT_EQ(header.height, 2U);
+    EXPECT_EQ(header.dataOffset, Frame::Header::DataAlignment);
+    EXPECT_EQ(header.dataSize, 6U * sizeof(BGRAPixel));
+
+    gsl::span<std::uint8_t const> const data{content.data() + header.dataOffset, header.dataSize};
+    EXPECT_EQ(header.checksum, Frame::checksum(data));
+    EXPECT_EQ(Frame::checkHeader(header, content.size()), nullptr);
+    EXPECT_EQ(std::memcmp(data.data(), &image[0U], data.size()), 0);
+}
+
+TEST_F(IOFrameWriter, PixelTags)
+{
+    EXPECT_EQ(Frame::pixelTagOf<BGRAPixel>(), Frame::PixelTag::bgra);
+    EXPECT_EQ(Frame::pixelTagOf<HSVAPixel>(), Frame::PixelTag::hsva);
+    EXPECT_EQ(Frame::pixelTagOf<MiniHSVPixel>(), Frame::PixelTag::miniHSV);
+    EXPECT_EQ(Frame::pixelTagOf<BGRAPixelFloat>(), Frame::PixelTag::unknown);
+    EXPECT_EQ(Frame::pixelSizeOf(Frame::PixelTag::unknown), 0U);
+}
+
+} // namespace Terrahertz::UnitTests
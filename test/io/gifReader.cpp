@@ -0,0 +1,183 @@
+#include "THzImage/io/gifReader.hpp"
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/gifWriter.hpp"
+
+#include <array>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct IOGIFReaderLZWDecoder : public testing::Test
+{
+    GIF::Internal::LZWDecoder sut{};
+};
+
+TEST_F(IOGIFReaderLZWDecoder, InvalidParametersAreRejected)
+{
+    std::array<std::uint8_t, 4U> const data{0x02U, 0x44U, 0x01U, 0x00U};
+    std::array<std::uint8_t, 4U>       output{};
+    EXPECT_EQ(sut.decode(1U, data, output), 0U);
+    EXPECT_EQ(sut.decode(9U, data, output), 0U);
+    EXPECT_EQ(sut.decode(2U, {}, output), 0U);
+}
+
+TEST_F(IOGIFReaderLZWDecoder, DecodingKnownSample)
+{
+    // sample image from "What's in a GIF" by Matthew Flickinger
+    std::vector<std::uint8_t> const data{0x16, 0x8C, 0x2D, 0x99, 0x87, 0x2A, 0x1C, 0xDC, 0x33, 0xA0, 0x02, 0x75,
+                                         0xEC, 0x95, 0xFA, 0xA8, 0xDE, 0x60, 0x8C, 0x04, 0x91, 0x4C, 0x01, 0x00};
+    std::array<std::uint8_t, 100U> const expected{
+        1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 0,
+        0, 0, 0, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 0, 0, 0, 0, 1,
+        1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1};
+
+    std::array<std::uint8_t, 100U> output{};
+    EXPECT_EQ(sut.decode(2U, data, output), output.size());
+    EXPECT_EQ(output, expected);
+
+    // decoding stops once the buffer is full
+    std::array<std::uint8_t, 7U> partial{};
+    EXPECT_EQ(sut.decode(2U, data, partial), partial.size());
+    EXPECT_TRUE(std::equal(partial.begin(), partial.end(), expected.begin()));
+}
+
+TEST_F(IOGIFReaderLZWDecoder, EncodedDataIsRestored)
+{
+    // random data fills the dictionary several times, long runs produce codes that are not yet in the table
+    std::mt19937                       generator{42U};
+    std::uniform_int_distribution<int> distribution{0, 15};
+    std::vector<std::uint8_t>          indices(100000U);
+    for (auto i = 0U; i < indices.size(); ++i)
+    {
+        indices[i] = static_cast<std::uint8_t>((i % 5000U) < 1000U ? 3 : distribution(generator));
+    }
+    GIF::Internal::LZWEncoder encoder{};
+    std::vector<std::uint8_t> data(GIF::Internal::LZWEncoder::maxEncodedSize(indices.size()));
+    data.resize(encoder.encode(4U, indices, data));
+    ASSERT_NE(data.size(), 0U);
+
+    std::vector<std::uint8_t> output(indices.size());
+    EXPECT_EQ(sut.decode(4U, data, output), output.size());
+    EXPECT_EQ(output, indices);
+}
+
+TEST_F(IOGIFReaderLZWDecoder, DecoderCanBeReusedWithLargerCodeSizes)
+{
+    // the strings added for a small code size must not remain as the indices of a larger one
+    GIF::Internal::LZWEncoder encoder{};
+    std::mt19937              generator{7U};
+    for (auto const minCodeSize : {2U, 4U, 8U, 3U, 8U})
+    {
+        std::uniform_int_distribution<int> distribution{0, (1 << minCodeSize) - 1};
+        std::vector<std::uint8_t>          indices(20000U);
+        for (auto &index : indices)
+        {
+            index = static_cast<std::uint8_t>(distribution(generator));
+        }
+        indices[0U] = indices[1U] = indices[2U] = indices[3U] = 6U % (1U << minCodeSize);
+
+        std::vector<std::uint8_t> data(GIF::Internal::LZWEncoder::maxEncodedSize(indices.size()));
+        data.resize(encoder.encode(static_cast<std::uint8_t>(minCodeSize), indices, data));
+        ASSERT_NE(data.size(), 0U);
+
+        std::vector<std::uint8_t> output(indices.size());
+        EXPECT_EQ(sut.decode(static_cast<std::uint8_t>(minCodeSize), data, output), output.size());
+        EXPECT_EQ(output, indices);
+    }
+}
+
+struct IOGIFReader : public testing::Test
+{
+    std::string filepath{"testRead.gif"};
+
+    BGRAImage createImage(std::uint32_t const offset) noexcept
+    {
+        std::array<BGRAPixel, 4U> const colors{
+            BGRAPixel{0xFFU, 0U, 0U}, BGRAPixel{0U, 0xFFU, 0U}, BGRAPixel{0U, 0U, 0xFFU}, BGRAPixel{0x40U, 0x80U, 0xC0U}};
+        BGRAImage image{};
+        (void)image.setDimensions(Rectangle{24U, 16U});
+        for (auto y = 0U; y < 16U; ++y)
+        {
+            for (auto x = 0U; x < 24U; ++x)
+            {
+                image[(y * 24U) + x] = colors[((x + offset) / 6U) % colors.size()];
+            }
+        }
+        return image;
+    }
+};
+
+TEST_F(IOGIFReader, NonExistingFile)
+{
+    BGRAImage   image{};
+    GIF::Reader sut{"nonExisting.gif"};
+    EXPECT_FALSE(sut.fileTypeFits());
+    EXPECT_FALSE(image.readFrom(sut));
+}
+
+TEST_F(IOGIFReader, FileOfOtherTypeIsRejected)
+{
+    {
+        std::ofstream stream{filepath, std::ios::binary};
+        stream << "GIF90a this is not an image";
+    }
+    BGRAImage   image{};
+    GIF::Reader sut{filepath};
+    EXPECT_FALSE(sut.fileTypeFits());
+    EXPECT_FALSE(image.readFrom(sut));
+}
+
+TEST_F(IOGIFReader, ReadingWrittenImage)
+{
+    auto image = createImage(0U);
+    // transparent pixels stay transparent
+    image[0U] = BGRAPixel{0U, 0U, 0U, 0U};
+
+    GIF::Writer writer{filepath};
+    ASSERT_TRUE(image.writeTo(&writer));
+
+    BGRAImage   read{};
+    GIF::Reader sut{filepath};
+    EXPECT_TRUE(sut.fileTypeFits());
+    EXPECT_TRUE(sut.imagePresent());
+    ASSERT_TRUE(read.readFrom(sut));
+    EXPECT_FALSE(sut.imagePresent());
+    EXPECT_EQ(read, image);
+}
+
+TEST_F(IOGIFReader, ReadingAnimationFrameByFrame)
+{
+    std::vector<BGRAImage> frames{};
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        frames.emplace_back(createImage(i * 6U));
+    }
+    // a small change only results in a small region being written
+    frames.emplace_back(frames.back());
+    frames.back()[(8U * 24U) + 11U] = BGRAPixel{0xFFU, 0U, 0U};
+
+    GIF::Writer writer{filepath};
+    ASSERT_TRUE(writer.beginAnimation());
+    for (auto const &frame : frames)
+    {
+        ASSERT_TRUE(frame.writeTo(&writer));
+    }
+    ASSERT_TRUE(writer.endAnimation());
+
+    BGRAImage   read{};
+    GIF::Reader sut{filepath};
+    for (auto const &frame : frames)
+    {
+        EXPECT_TRUE(sut.imagePresent());
+        ASSERT_TRUE(read.readFrom(sut));
+        EXPECT_EQ(read, frame);
+    }
+    EXPECT_FALSE(sut.imagePresent());
+    EXPECT_FALSE(read.readFrom(sut));
+}
+
+} // namespace Terrahertz::UnitTests
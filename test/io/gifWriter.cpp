@@ -1,9 +1,14 @@
 #include "THzImage/io/gifWriter.hpp"
 
 #include "THzImage/common/image.hpp"
+#include "THzImage/io/gifReader.hpp"
 #include "THzImage/io/testImageGenerator.hpp"
 
+#include <array>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -41,10 +46,109 @@ TEST_F(IOGIFWriterColorReduction, ConversionResultCloseToOriginal)
         accumulatedDeviations += oColor.distanceSquared(rColor);
     }
     accumulatedDeviations /= image.dimensions().area();
-    EXPECT_NEAR(accumulatedDeviations, 268.63, 0.05);
+    EXPECT_NEAR(accumulatedDeviations, 241.07, 0.05);
 }
 
-TEST_F(IOGIFWriterColorReduction, ReductionGivenDataWithLessThan255Colors) {}
+TEST_F(IOGIFWriterColorReduction, MultipleThreadsSelectTheSameColors)
+{
+    // large enough to be split between multiple threads
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{640U, 480U}};
+    ASSERT_TRUE(image.readFrom(generator));
+    gsl::span<BGRAPixel const> const buffer{&image[0U], image.dimensions().area()};
+
+    GIF::Internal::ColorReduction threaded{4U};
+    GIF::Internal::ColorReduction exact{1U, true};
+    GIF::Internal::ColorReduction threadedExact{4U, true};
+    sut.analyze(buffer);
+    threaded.analyze(buffer);
+    exact.analyze(buffer);
+    threadedExact.analyze(buffer);
+    auto const colorTable = sut.colorTable();
+    ASSERT_EQ(threaded.colorTable().size(), colorTable.size());
+    for (auto i = 0U; i < colorTable.size(); ++i)
+    {
+        EXPECT_EQ(threaded.colorTable()[i], colorTable[i]);
+    }
+    for (auto const &pixel : buffer)
+    {
+        ASSERT_EQ(threaded.convert(pixel), sut.convert(pixel));
+        ASSERT_EQ(threadedExact.convert(pixel), exact.convert(pixel));
+    }
+}
+
+TEST_F(IOGIFWriterColorReduction, ExactConversionResultCloserToOriginal)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{64U, 64U}};
+    EXPECT_TRUE(image.readFrom(generator));
+    GIF::Internal::ColorReduction exact{1U, true};
+    exact.analyze(gsl::span<BGRAPixel const>{&image[0U], image.dimensions().area()});
+    auto const colorTable = exact.colorTable();
+
+    auto accumulatedDeviations = 0.0;
+    for (auto const i : image.dimensions().range())
+    {
+        auto const oColor = image[i];
+        auto const rColor = colorTable[exact.convert(oColor)];
+        accumulatedDeviations += oColor.distanceSquared(rColor);
+    }
+    accumulatedDeviations /= image.dimensions().area();
+    EXPECT_NEAR(accumulatedDeviations, 230.81, 0.05);
+}
+
+TEST_F(IOGIFWriterColorReduction, InverseColormapContainsTheClosestColors)
+{
+    std::mt19937                       generator{7U};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    std::vector<BGRAPixel>             buffer(4096U);
+    for (auto &pixel : buffer)
+    {
+        pixel = BGRAPixel{static_cast<std::uint8_t>(distribution(generator)),
+                          static_cast<std::uint8_t>(distribution(generator)),
+                          static_cast<std::uint8_t>(distribution(generator))};
+    }
+    sut.analyze(buffer);
+    auto const colorTable = sut.colorTable();
+
+    // the centers of the quantized colors are mapped to the closest color of the table
+    for (auto b = 4U; b < 256U; b += 8U)
+    {
+        for (auto g = 4U; g < 256U; g += 8U)
+        {
+            for (auto r = 4U; r < 256U; r += 8U)
+            {
+                BGRAPixel const color{
+                    static_cast<std::uint8_t>(b), static_cast<std::uint8_t>(g), static_cast<std::uint8_t>(r)};
+                auto closest = color.distanceSquared(colorTable[0U]);
+                for (auto const &entry : colorTable)
+                {
+                    closest = std::min(closest, color.distanceSquared(entry));
+                }
+                ASSERT_EQ(color.distanceSquared(colorTable[sut.convert(color)]), closest);
+            }
+        }
+    }
+}
+
+TEST_F(IOGIFWriterColorReduction, ReductionGivenDataWithLessThan255Colors)
+{
+    // colors in separate histogram bins are kept unchanged
+    std::vector<BGRAPixel> buffer{};
+    for (auto i = 0U; i < 200U; ++i)
+    {
+        BGRAPixel const color{
+            static_cast<std::uint8_t>((i % 16U) * 16U), static_cast<std::uint8_t>((i / 16U) * 16U), 0x80U};
+        buffer.insert(buffer.end(), i + 1U, color);
+    }
+    sut.analyze(buffer);
+    auto const colorTable = sut.colorTable();
+    EXPECT_EQ(colorTable.size(), 200U);
+    for (auto const &pixel : buffer)
+    {
+        EXPECT_EQ(colorTable[sut.convert(pixel)], pixel);
+    }
+}
 
 struct IO_GIFWriterDithering : public testing::Test
 {
@@ -78,7 +182,361 @@ TEST_F(IO_GIFWriterDithering, ConversionResultCloseToOriginal)
         accumulatedDeviations += oColor.distanceSquared(rColor);
     }
     accumulatedDeviations /= image.dimensions().area();
-    EXPECT_NEAR(accumulatedDeviations, 345.74, 0.05);
+    EXPECT_NEAR(accumulatedDeviations, 308.50, 0.05);
+}
+
+struct IOGIFWriterOrderedDithering : public testing::Test
+{
+    void SetUp() noexcept override
+    {
+        TestImageGenerator generator{Rectangle{64U, 64U}};
+        ASSERT_TRUE(image.readFrom(generator));
+        colorReduction.analyze(gsl::span<BGRAPixel const>{&image[0U], image.dimensions().area()});
+    }
+
+    BGRAImage                       image{};
+    GIF::Internal::ColorReduction   colorReduction{};
+    GIF::Internal::OrderedDithering sut{};
+};
+
+TEST_F(IOGIFWriterOrderedDithering, InitialStateCorrect)
+{
+    for (auto i = 0U; i < 256U; ++i)
+    {
+        BGRAPixel pixel{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i)};
+        EXPECT_EQ(sut.convert(pixel, i, i), 0U);
+    }
+}
+
+TEST_F(IOGIFWriterOrderedDithering, ConversionResultCloseToOriginal)
+{
+    auto const colorTable = colorReduction.colorTable();
+
+    auto accumulatedDeviations = 0.0;
+    sut.setParameters(colorReduction);
+    for (auto y = 0U; y < image.dimensions().height; ++y)
+    {
+        for (auto x = 0U; x < image.dimensions().width; ++x)
+        {
+            auto const oColor = image[(y * image.dimensions().width) + x];
+            auto const rColor = colorTable[sut.convert(oColor, x, y)];
+            accumulatedDeviations += oColor.distanceSquared(rColor);
+        }
+    }
+    accumulatedDeviations /= image.dimensions().area();
+    EXPECT_NEAR(accumulatedDeviations, 391.62, 0.05);
+}
+
+TEST_F(IOGIFWriterOrderedDithering, ConvertingAllRowsMatchesConvertingEachPixel)
+{
+    // large enough to be split between multiple threads
+    BGRAImage          large{};
+    TestImageGenerator generator{Rectangle{640U, 480U}};
+    ASSERT_TRUE(large.readFrom(generator));
+    sut.setParameters(colorReduction);
+
+    GIF::Internal::OrderedDithering threaded{4U};
+    threaded.setParameters(colorReduction);
+    std::vector<std::uint8_t> indices(large.dimensions().area());
+    threaded.convert(large.dimensions().width, gsl::span<BGRAPixel const>{&large[0U], indices.size()}, indices);
+    for (auto y = 0U; y < large.dimensions().height; ++y)
+    {
+        for (auto x = 0U; x < large.dimensions().width; ++x)
+        {
+            auto const i = (y * large.dimensions().width) + x;
+            ASSERT_EQ(indices[i], sut.convert(large[i], x, y));
+        }
+    }
+}
+
+struct IOGIFWriterLZWEncoder : public testing::Test
+{
+    GIF::Internal::LZWEncoder sut{};
+};
+
+TEST_F(IOGIFWriterLZWEncoder, InvalidParametersAreRejected)
+{
+    std::array<std::uint8_t, 4U>  indices{};
+    std::vector<std::uint8_t>     output(GIF::Internal::LZWEncoder::maxEncodedSize(indices.size()));
+    gsl::span<std::uint8_t> const tooSmall{output.data(), output.size() - 1U};
+    EXPECT_EQ(sut.encode(1U, indices, output), 0U);
+    EXPECT_EQ(sut.encode(9U, indices, output), 0U);
+    EXPECT_EQ(sut.encode(2U, indices, tooSmall), 0U);
+}
+
+TEST_F(IOGIFWriterLZWEncoder, EncodingKnownSample)
+{
+    // sample image from "What's in a GIF" by Matthew Flickinger
+    std::array<std::uint8_t, 100U> const indices{
+        1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 0,
+        0, 0, 0, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 0, 0, 0, 0, 1,
+        1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1};
+    std::vector<std::uint8_t> const expected{0x16, 0x8C, 0x2D, 0x99, 0x87, 0x2A, 0x1C, 0xDC, 0x33, 0xA0, 0x02, 0x75,
+                                             0xEC, 0x95, 0xFA, 0xA8, 0xDE, 0x60, 0x8C, 0x04, 0x91, 0x4C, 0x01, 0x00};
+
+    std::vector<std::uint8_t> output(GIF::Internal::LZWEncoder::maxEncodedSize(indices.size()));
+    auto const                size = sut.encode(2U, indices, output);
+    output.resize(size);
+    EXPECT_EQ(output, expected);
+}
+
+TEST_F(IOGIFWriterLZWEncoder, OutputIsSplitIntoSubBlocks)
+{
+    // random data fills the dictionary several times and produces a lot of sub-blocks
+    std::mt19937                       generator{42U};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    std::vector<std::uint8_t>          indices(100000U);
+    for (auto &index : indices)
+    {
+        index = static_cast<std::uint8_t>(distribution(generator));
+    }
+    std::vector<std::uint8_t> output(GIF::Internal::LZWEncoder::maxEncodedSize(indices.size()));
+    auto const                size = sut.encode(8U, indices, output);
+    ASSERT_NE(size, 0U);
+
+    size_t position{};
+    while (output[position] == 255U)
+    {
+        position += 256U;
+        ASSERT_LT(position, size);
+    }
+    position += output[position] + 1U;
+    ASSERT_LT(position, size);
+    EXPECT_EQ(output[position], 0U);
+    EXPECT_EQ(position + 1U, size);
+}
+
+struct IOGIFWriter : public testing::Test
+{
+    std::string filepath{"test.gif"};
+
+    std::vector<std::uint8_t> readFile() noexcept
+    {
+        std::ifstream             stream{filepath, std::ios::binary};
+        std::vector<std::uint8_t> content{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+        return content;
+    }
+};
+
+TEST_F(IOGIFWriter, ImageDimensionsNotMatchingTheBufferFail)
+{
+    std::array<BGRAPixel, 4U> buffer{};
+
+    GIF::Writer sut{filepath};
+    ASSERT_TRUE(sut.init());
+    EXPECT_FALSE(sut.write(Rectangle{3U, 2U}, buffer));
+    EXPECT_FALSE(sut.write(Rectangle{0x10000U, 0U}, buffer));
+    sut.deinit();
+}
+
+TEST_F(IOGIFWriter, FileStructure)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{32U, 16U}};
+    ASSERT_TRUE(image.readFrom(generator));
+
+    GIF::Writer sut{filepath};
+    ASSERT_TRUE(image.writeTo(&sut));
+
+    auto const content = readFile();
+    ASSERT_GT(content.size(), 13U + 768U + 10U);
+    EXPECT_EQ(std::string(content.begin(), content.begin() + 6U), "GIF89a");
+    EXPECT_EQ(content[6U], 32U);
+    EXPECT_EQ(content[8U], 16U);
+    // global color table with 256 entries
+    EXPECT_EQ(content[10U], 0xF7U);
+    // no transparency, so the image descriptor follows right away
+    EXPECT_EQ(content[13U + 768U], 0x2CU);
+    EXPECT_EQ(content[13U + 768U + 10U], 8U);
+    EXPECT_EQ(content.back(), 0x3BU);
+}
+
+TEST_F(IOGIFWriter, TransparentPixelsUseTheIndexAfterTheColorTable)
+{
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{4U, 4U}));
+    for (auto i = 0U; i < 16U; ++i)
+    {
+        image[i] = (i % 2U) == 0U ? BGRAPixel{0xFFU, 0U, 0U, 0U} : BGRAPixel{0U, 0U, 0xFFU};
+    }
+
+    GIF::Writer sut{filepath};
+    ASSERT_TRUE(image.writeTo(&sut));
+
+    auto const content = readFile();
+    auto const colors  = 1U << ((content[10U] & 0x07U) + 1U);
+    ASSERT_GT(content.size(), 13U + colors * 3U + 8U);
+    auto const extension = content.begin() + 13U + colors * 3U;
+    EXPECT_EQ(extension[0U], 0x21U);
+    EXPECT_EQ(extension[1U], 0xF9U);
+    EXPECT_EQ(extension[3U] & 0x01U, 0x01U);
+    EXPECT_LT(extension[6U], colors);
+}
+
+TEST_F(IOGIFWriter, OrderedDitheringKeepsDistantColors)
+{
+    std::array<BGRAPixel, 3U> const colors{BGRAPixel{0xFFU, 0U, 0U}, BGRAPixel{0U, 0xFFU, 0U}, BGRAPixel{0U, 0U, 0xFFU}};
+    BGRAImage                       image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{30U, 20U}));
+    for (auto i = 0U; i < image.dimensions().area(); ++i)
+    {
+        image[i] = colors[(i / 7U) % colors.size()];
+    }
+
+    GIF::Writer sut{filepath, GIF::DitheringMode::ordered};
+    ASSERT_TRUE(image.writeTo(&sut));
+
+    BGRAImage   read{};
+    GIF::Reader reader{filepath};
+    ASSERT_TRUE(read.readFrom(reader));
+    EXPECT_EQ(read, image);
+}
+
+TEST_F(IOGIFWriter, MultipleThreadsWriteTheSameFile)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{640U, 480U}};
+    ASSERT_TRUE(image.readFrom(generator));
+
+    GIF::Writer single{filepath, GIF::DitheringMode::ordered};
+    ASSERT_TRUE(image.writeTo(&single));
+    auto const expected = readFile();
+
+    GIF::Writer sut{filepath, GIF::DitheringMode::ordered, 4U};
+    ASSERT_TRUE(image.writeTo(&sut));
+    EXPECT_EQ(readFile(), expected);
+}
+
+TEST_F(IOGIFWriter, ExactMappingReducesTheColorError)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{64U, 64U}};
+    ASSERT_TRUE(image.readFrom(generator));
+
+    auto const colorError = [&](bool const exact) noexcept {
+        GIF::Writer sut{filepath, GIF::DitheringMode::errorDiffusion, 1U, exact};
+        EXPECT_TRUE(image.writeTo(&sut));
+
+        BGRAImage   read{};
+        GIF::Reader reader{filepath};
+        EXPECT_TRUE(read.readFrom(reader));
+        auto accumulatedDeviations = 0.0;
+        for (auto const i : image.dimensions().range())
+        {
+            accumulatedDeviations += image[i].distanceSquared(read[i]);
+        }
+        return accumulatedDeviations / image.dimensions().area();
+    };
+    EXPECT_LT(colorError(true), colorError(false));
+}
+
+TEST_F(IOGIFWriter, IndicesOutsideOfThePaletteFail)
+{
+    // 4 colors are written with 2 bits, so index 4 would be encoded as the clear code
+    std::array<BGRAPixel, 4U> const palette{
+        BGRAPixel{1U, 2U, 3U}, BGRAPixel{4U, 5U, 6U}, BGRAPixel{7U, 8U, 9U}, BGRAPixel{10U, 11U, 12U}};
+    IndexedImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{2U, 2U}));
+    ASSERT_TRUE(image.setPalette(palette));
+    image[3U] = 4U;
+
+    GIF::Writer sut{filepath};
+    EXPECT_FALSE(sut.write(image));
+    image[3U] = 3U;
+    EXPECT_TRUE(sut.write(image));
+}
+
+TEST_F(IOGIFWriter, WritingIndexedImage)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{32U, 24U}};
+    ASSERT_TRUE(image.readFrom(generator));
+    image[5U] = BGRAPixel{0U, 0U, 0U, 0U};
+
+    IndexedImage indexed{};
+    ASSERT_TRUE(indexed.convertFrom(image));
+    BGRAImage expected{};
+    ASSERT_TRUE(indexed.expandInto(expected));
+
+    GIF::Writer sut{filepath};
+    ASSERT_TRUE(sut.write(indexed));
+
+    // the palette is used as it is, so the result matches the expanded image
+    BGRAImage   read{};
+    GIF::Reader reader{filepath};
+    ASSERT_TRUE(read.readFrom(reader));
+    EXPECT_EQ(read, expected);
+
+    ASSERT_TRUE(sut.beginAnimation());
+    EXPECT_FALSE(sut.write(indexed));
+}
+
+TEST_F(IOGIFWriter, AnimationNeedsAtLeastOneFrame)
+{
+    GIF::Writer sut{filepath};
+    EXPECT_FALSE(sut.endAnimation());
+    ASSERT_TRUE(sut.beginAnimation());
+    EXPECT_FALSE(sut.beginAnimation());
+    EXPECT_FALSE(sut.endAnimation());
+}
+
+TEST_F(IOGIFWriter, AnimationOnlyContainsChangedRegions)
+{
+    BGRAImage          image{};
+    TestImageGenerator generator{Rectangle{40U, 30U}};
+    ASSERT_TRUE(image.readFrom(generator));
+
+    GIF::Writer sut{filepath};
+    ASSERT_TRUE(sut.beginAnimation(GIF::AnimationOptions{5U, 3U}));
+    ASSERT_TRUE(image.writeTo(&sut));
+    // unchanged frame only extends the delay of the previous one
+    ASSERT_TRUE(image.writeTo(&sut));
+    image[(12U * 40U) + 7U]  = BGRAPixel{1U, 2U, 3U};
+    image[(14U * 40U) + 21U] = BGRAPixel{1U, 2U, 3U};
+    ASSERT_TRUE(image.writeTo(&sut));
+
+    BGRAImage smaller{};
+    ASSERT_TRUE(smaller.setDimensions(Rectangle{20U, 30U}));
+    EXPECT_FALSE(smaller.writeTo(&sut));
+    ASSERT_TRUE(sut.endAnimation());
+
+    auto const content = readFile();
+    auto const colors  = 1U << ((content[10U] & 0x07U) + 1U);
+    auto       pos     = 13U + colors * 3U;
+    // loop extension
+    ASSERT_GT(content.size(), pos + 19U);
+    EXPECT_EQ(content[pos + 1U], 0xFFU);
+    EXPECT_EQ(content[pos + 16U], 3U);
+    pos += 19U;
+
+    std::vector<std::array<std::uint16_t, 5U>> frames{};
+    while ((pos < content.size()) && (content[pos] == 0x21U))
+    {
+        auto const delay = static_cast<std::uint16_t>(content[pos + 4U] | (content[pos + 5U] << 8U));
+        pos += 8U;
+        ASSERT_EQ(content[pos], 0x2CU);
+        auto const word = [&](size_t const offset) noexcept -> std::uint16_t {
+            return static_cast<std::uint16_t>(content[pos + offset] | (content[pos + offset + 1U] << 8U));
+        };
+        frames.push_back({delay, word(1U), word(3U), word(5U), word(7U)});
+        pos += 10U;
+        if ((content[pos - 1U] & 0x80U) != 0U)
+        {
+            pos += 3U << ((content[pos - 1U] & 0x07U) + 1U);
+        }
+        // skip the minimum code size and the sub-blocks
+        ++pos;
+        while (content[pos] != 0U)
+        {
+            pos += content[pos] + 1U;
+        }
+        ++pos;
+    }
+    ASSERT_EQ(frames.size(), 2U);
+    EXPECT_EQ(frames[0U], (std::array<std::uint16_t, 5U>{10U, 0U, 0U, 40U, 30U}));
+    EXPECT_EQ(frames[1U], (std::array<std::uint16_t, 5U>{5U, 7U, 12U, 15U, 3U}));
+    ASSERT_EQ(pos + 1U, content.size());
+    EXPECT_EQ(content[pos], 0x3BU);
 }
 
 } // namespace Terrahertz::UnitTests
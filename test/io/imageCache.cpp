@@ -0,0 +1,280 @@
+#include "THzImage/io/imageCache.hpp"
+
+#include "THzImage/common/image.hpp"
+#include "THzImage/io/autoFileReader.hpp"
+#include "THzImage/io/imageDirectoryReader.hpp"
+#include "THzImage/io/pngWriter.hpp"
+#include "THzImage/io/testImageGenerator.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct IOImageCache : public testing::Test
+{
+    static constexpr size_t ImageBytes{16U * 16U * sizeof(BGRAPixel)};
+
+    void SetUp() noexcept override
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        TestImageGenerator generator{Rectangle{16U, 16U}};
+        (void)testImage.readFrom(generator);
+    }
+
+    void TearDown() noexcept override { std::filesystem::remove_all(directory); }
+
+    std::filesystem::path writeFile(std::string const &name, std::uint8_t const blue) noexcept
+    {
+        auto const path = directory / name;
+        testImage[0U].blue = blue;
+        PNG::Writer writer{path};
+        EXPECT_TRUE(testImage.writeTo(&writer));
+        return path;
+    }
+
+    SharedImage<BGRAPixel> shared() const noexcept { return SharedImage<BGRAPixel>::copyOf(testImage); }
+
+    std::filesystem::path directory{"imageCacheTest"};
+
+    BGRAImage testImage{};
+};
+
+TEST_F(IOImageCache, InsertedImageIsFound)
+{
+    auto const path = writeFile("image.png", 1U);
+
+    ImageCache sut{ImageBytes};
+    EXPECT_FALSE(sut.find(path));
+    auto const image = shared();
+    sut.insert(path, image);
+    EXPECT_EQ(sut.size(), 1U);
+    EXPECT_EQ(sut.usedBytes(), ImageBytes);
+
+    // different spellings of the same path refer to the same file
+    EXPECT_EQ(sut.find(path).get(), image.get());
+    EXPECT_EQ(sut.find(directory / "." / "image.png").get(), image.get());
+    EXPECT_FALSE(sut.find(directory / "nonExisting.png"));
+
+    sut.clear();
+    EXPECT_EQ(sut.size(), 0U);
+    EXPECT_EQ(sut.usedBytes(), 0U);
+    EXPECT_FALSE(sut.find(path));
+}
+
+TEST_F(IOImageCache, ChangedFileIsNotFound)
+{
+    auto const path = writeFile("image.png", 1U);
+
+    ImageCache sut{ImageBytes};
+    sut.insert(path, shared());
+    {
+        std::ofstream stream{path, std::ios::binary | std::ios::app};
+        stream << "changed";
+    }
+    EXPECT_FALSE(sut.find(path));
+    EXPECT_EQ(sut.size(), 0U);
+    EXPECT_EQ(sut.usedBytes(), 0U);
+}
+
+TEST_F(IOImageCache, LeastRecentlyUsedImageIsEvicted)
+{
+    auto const path0 = writeFile("image0.png", 0U);
+    auto const path1 = writeFile("image1.png", 1U);
+    auto const path2 = writeFile("image2.png", 2U);
+    auto const large = writeFile("large.png", 3U);
+
+    ImageCache sut{2U * ImageBytes};
+    sut.insert(path0, shared());
+    sut.insert(path1, shared());
+    EXPECT_TRUE(sut.find(path0));
+    sut.insert(path2, shared());
+    EXPECT_EQ(sut.size(), 2U);
+    EXPECT_EQ(sut.usedBytes(), 2U * ImageBytes);
+    EXPECT_TRUE(sut.find(path0));
+    EXPECT_FALSE(sut.find(path1));
+    EXPECT_TRUE(sut.find(path2));
+
+    // images larger than the budget are not kept at all
+    BGRAImage largeImage{};
+    ASSERT_TRUE(largeImage.setDimensions(Rectangle{32U, 32U}));
+    sut.insert(large, SharedImage<BGRAPixel>::copyOf(largeImage));
+    EXPECT_FALSE(sut.find(large));
+    EXPECT_EQ(sut.size(), 2U);
+}
+
+TEST_F(IOImageCache, SpilledImageIsFoundByAnotherCache)
+{
+    auto const path  = writeFile("image.png", 1U);
+    auto const spill = directory / "spill";
+    {
+        ImageCache sut{0U, spill};
+        sut.insert(path, shared());
+        EXPECT_EQ(sut.size(), 0U);
+    }
+
+    ImageCache sut{ImageBytes, spill};
+    auto const image = sut.find(path);
+    ASSERT_TRUE(image);
+    EXPECT_EQ(*image, testImage);
+    EXPECT_EQ(sut.size(), 1U);
+
+    ImageCache withoutSpill{ImageBytes};
+    EXPECT_FALSE(withoutSpill.find(path));
+}
+
+TEST_F(IOImageCache, ConcurrentSpillingOfTheSameImage)
+{
+    auto const path  = writeFile("image.png", 1U);
+    auto const spill = directory / "spill";
+    {
+        ImageCache               sut{0U, spill};
+        std::vector<std::thread> threads{};
+        for (auto i = 0U; i < 8U; ++i)
+        {
+            threads.emplace_back([&]() noexcept { sut.insert(path, shared()); });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+    auto files = 0U;
+    for (auto const &entry : std::filesystem::directory_iterator{spill})
+    {
+        EXPECT_EQ(entry.path().extension(), ".thzf");
+        ++files;
+    }
+    EXPECT_EQ(files, 1U);
+
+    ImageCache sut{ImageBytes, spill};
+    auto const image = sut.find(path);
+    ASSERT_TRUE(image);
+    EXPECT_EQ(*image, testImage);
+}
+
+TEST_F(IOImageCache, SpilledImageOfAnotherFileIsNotUsed)
+{
+    auto const path  = writeFile("image.png", 1U);
+    auto const spill = directory / "spill";
+    {
+        ImageCache sut{0U, spill};
+        sut.insert(path, shared());
+    }
+
+    // change the last character of the key stored behind the pixel data, as if another file had the same hash
+    std::filesystem::path spilled{};
+    for (auto const &entry : std::filesystem::directory_iterator{spill})
+    {
+        spilled = entry.path();
+    }
+    {
+        std::fstream stream{spilled, std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekp(-1, std::ios::end);
+        stream.put('#');
+    }
+    ImageCache sut{ImageBytes, spill};
+    EXPECT_FALSE(sut.find(path));
+
+    // inserting the image again replaces the spilled image
+    sut.insert(path, shared());
+    ImageCache other{ImageBytes, spill};
+    auto const image = other.find(path);
+    ASSERT_TRUE(image);
+    EXPECT_EQ(*image, testImage);
+}
+
+TEST_F(IOImageCache, AutoFileReaderSkipsDecodingCachedImages)
+{
+    auto const path     = writeFile("image.png", 1U);
+    auto const expected = testImage;
+
+    ImageCache       cache{ImageBytes};
+    BGRAImage        image{};
+    AutoFile::Reader sut{path, AutoFile::Reader::ExtensionMode::lenient, &cache};
+    ASSERT_TRUE(sut.readInto(image));
+    EXPECT_EQ(image, expected);
+    EXPECT_EQ(cache.size(), 1U);
+
+    // destroy the content while keeping size and modification time, only the cache can deliver the image now
+    auto const modified = std::filesystem::last_write_time(path);
+    auto const size     = std::filesystem::file_size(path);
+    {
+        std::ofstream stream{path, std::ios::binary};
+        stream << std::string(size, '\0');
+    }
+    std::filesystem::last_write_time(path, modified);
+
+    BGRAImage cached{};
+    sut.reset(path, AutoFile::Reader::ExtensionMode::lenient);
+    ASSERT_TRUE(sut.readInto(cached));
+    EXPECT_EQ(cached, expected);
+
+    // strict mode still checks the content of the file
+    sut.reset(path, AutoFile::Reader::ExtensionMode::strict);
+    EXPECT_FALSE(sut.readInto(cached));
+}
+
+TEST_F(IOImageCache, AutoFileReaderCachesTheVersionItOpened)
+{
+    auto const path     = writeFile("image.png", 1U);
+    auto const expected = testImage;
+
+    ImageCache       cache{ImageBytes};
+    AutoFile::Reader sut{path, AutoFile::Reader::ExtensionMode::lenient, &cache};
+    ASSERT_TRUE(sut.init());
+
+    // replace the file while it is being decoded, the reader keeps reading the version it opened
+    auto const modified    = std::filesystem::last_write_time(path);
+    auto const replacement = writeFile("replacement.png", 2U);
+    std::filesystem::last_write_time(replacement, modified + std::chrono::hours{1});
+    std::filesystem::rename(replacement, path);
+
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(sut.dimensions()));
+    ASSERT_TRUE(sut.read(gsl::span<BGRAPixel>{&image[0U], image.dimensions().area()}));
+    sut.deinit();
+    EXPECT_EQ(image, expected);
+    EXPECT_EQ(cache.size(), 1U);
+
+    // the decoded image belongs to the previous version, so the new one is not found
+    EXPECT_FALSE(cache.find(path));
+}
+
+TEST_F(IOImageCache, DirectoryReaderFillsCache)
+{
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        (void)writeFile("image" + std::to_string(i) + ".png", static_cast<std::uint8_t>(i));
+    }
+    auto const readAll = [&](ImageCache &cache) noexcept {
+        std::vector<BGRAImage> images{};
+        ImageDirectory::Reader sut{
+            directory, ImageDirectory::Reader::Mode::automatic, 2U, ImageDirectory::Reader::Order::directory, &cache};
+        BGRAImage image{};
+        while (sut.imagePresent())
+        {
+            if (sut.readInto(image))
+            {
+                images.emplace_back(image);
+            }
+        }
+        return images;
+    };
+
+    ImageCache cache{4U * ImageBytes};
+    auto const cold = readAll(cache);
+    EXPECT_EQ(cold.size(), 4U);
+    EXPECT_EQ(cache.size(), 4U);
+    EXPECT_EQ(readAll(cache), cold);
+    EXPECT_EQ(cache.size(), 4U);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -10,6 +10,8 @@
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <map>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -204,4 +206,79 @@ TEST_F(IOImageDirectoryReader, AutomaticMode)
     EXPECT_EQ(imageCounter, 5U);
 }
 
+TEST_F(IOImageDirectoryReader, WorkersDeliverInDirectoryOrder)
+{
+    using Mode = ImageDirectory::Reader::Mode;
+
+    struct Delivery
+    {
+        std::filesystem::path path;
+
+        bool success;
+
+        std::uint8_t blue;
+
+        bool operator==(Delivery const &other) const noexcept = default;
+    };
+    auto const readAll = [](ImageDirectory::Reader &reader) noexcept {
+        std::vector<Delivery> deliveries{};
+        BGRAImage             image{};
+        while (reader.imagePresent())
+        {
+            auto const success = reader.readInto(image);
+            auto const blue    = success ? image[0U].blue : std::uint8_t{};
+            deliveries.emplace_back(Delivery{reader.pathOfLastImage(), success, blue});
+        }
+        return deliveries;
+    };
+
+    for (auto const mode : {Mode::automatic, Mode::extensionBased, Mode::strictExtensionBased})
+    {
+        ImageDirectory::Reader sequential{"directoryReaderTest", mode};
+        ImageDirectory::Reader parallel{"directoryReaderTest", mode, 3U};
+        EXPECT_EQ(readAll(parallel), readAll(sequential));
+    }
+}
+
+TEST_F(IOImageDirectoryReader, WorkersDeliverInOrderOfCompletion)
+{
+    ImageDirectory::Reader sut{
+        "directoryReaderTest", ImageDirectory::Reader::Mode::automatic, 2U, ImageDirectory::Reader::Order::completion};
+
+    std::map<std::uint8_t, std::filesystem::path> const expected{
+        {0x0FU, "directoryReaderTest/subDir/containsImage"},
+        {0x1FU, "directoryReaderTest/subDir/testQoi.qoi"},
+        {0x2FU, "directoryReaderTest/actuallyQoi.png"},
+        {0x3FU, "directoryReaderTest/testBmp.bmp"},
+        {0x4FU, "directoryReaderTest/testPng.png"}};
+    std::map<std::uint8_t, std::filesystem::path> delivered{};
+
+    BGRAImage image{};
+    while (sut.imagePresent())
+    {
+        if (sut.readInto(image))
+        {
+            EXPECT_EQ(image.dimensions(), (Rectangle{16U, 16U}));
+            delivered.emplace(image[0U].blue, sut.pathOfLastImage());
+        }
+    }
+    EXPECT_EQ(delivered, expected);
+    EXPECT_FALSE(sut.readInto(image));
+}
+
+TEST_F(IOImageDirectoryReader, WorkersStopIfReaderIsDestroyedEarly)
+{
+    BGRAImage image{};
+    {
+        ImageDirectory::Reader sut{"directoryReaderTest", ImageDirectory::Reader::Mode::automatic, 1U};
+        EXPECT_TRUE(sut.imagePresent());
+        EXPECT_TRUE(sut.readInto(image));
+    }
+    {
+        ImageDirectory::Reader sut{"nonExistingDirectory", ImageDirectory::Reader::Mode::automatic, 2U};
+        EXPECT_FALSE(sut.imagePresent());
+        EXPECT_FALSE(sut.readInto(image));
+    }
+}
+
 } // namespace Terrahertz::UnitTests
@@ -6,9 +6,14 @@
 #include "THzImage/io/qoiReader.hpp"
 #include "THzImage/io/qoiWriter.hpp"
 
+#include <array>
 #include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -112,4 +117,58 @@ TEST_F(IOImageSeriesWriter, StartNumberAndIncrementNotDefaultValues)
     checkImage("./32_000007.qoi");
 }
 
+TEST_F(IOImageSeriesWriter, ParallelModeKeepsNumbering)
+{
+    auto writer = ImageSeries::Writer<QOI::Writer>::createWriter("./parallel_?.qoi", 1U, 2U);
+    ASSERT_TRUE(writer);
+    EXPECT_FALSE(writer->writeParallel(SharedImage<BGRAPixel>::copyOf(BGRAImage{})));
+    EXPECT_FALSE(writer->startParallel(0U, 4U));
+    ASSERT_TRUE(writer->startParallel(3U, 4U));
+    EXPECT_FALSE(writer->startParallel(3U, 4U));
+
+    std::vector<SharedImage<BGRAPixel>> images{};
+    for (auto i = 0U; i < 8U; ++i)
+    {
+        auto image = std::make_shared<BGRAImage>();
+        ASSERT_TRUE(image->setDimensions(Rectangle{i + 1U, 2U}));
+        image->operator[](0U) = BGRAPixel{static_cast<std::uint8_t>(i), 10U, 10U};
+        images.emplace_back(std::move(image));
+        EXPECT_EQ(writer->writeParallel(images.back()), 1U + (2U * i));
+    }
+    EXPECT_TRUE(writer->flushParallel().empty());
+
+    for (auto i = 0U; i < 8U; ++i)
+    {
+        std::array<char, 32U> filepath{};
+        std::snprintf(filepath.data(), filepath.size(), "./parallel_%06d.qoi", 1U + (2U * i));
+        BGRAImage   loadedImage{};
+        QOI::Reader reader{filepath.data()};
+        ASSERT_TRUE(loadedImage.readFrom(reader));
+        EXPECT_EQ(loadedImage, *images[i]);
+    }
+}
+
+TEST_F(IOImageSeriesWriter, ParallelModeReportsFailures)
+{
+    auto writer = ImageSeries::Writer<QOI::Writer>::createWriter("./doesNotExist/?.qoi");
+    ASSERT_TRUE(writer);
+
+    std::vector<std::uint32_t> reported{};
+    std::mutex                 mutex{};
+    ASSERT_TRUE(writer->startParallel(2U, 2U, [&](std::uint32_t const number, bool const written) {
+        std::lock_guard lock{mutex};
+        EXPECT_FALSE(written);
+        reported.emplace_back(number);
+    }));
+
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{2U, 2U}));
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        EXPECT_TRUE(writer->writeParallel(SharedImage<BGRAPixel>::copyOf(image)));
+    }
+    EXPECT_EQ(writer->flushParallel(), (std::vector<std::uint32_t>{0U, 1U, 2U}));
+    EXPECT_EQ(reported.size(), 3U);
+}
+
 } // namespace Terrahertz::UnitTests
@@ -58,4 +58,62 @@ TEST_F(IOPNGReader, ConstructionCorrect)
     }
 }
 
+TEST_F(IOPNGReader, ReadingRowByRow)
+{
+    std::array<BGRAPixel, 100U> imageData{};
+
+    std::uint8_t index = 1U;
+    for (auto &pixel : imageData)
+    {
+        pixel.red   = index;
+        pixel.green = static_cast<std::uint8_t>(index * 2U);
+        pixel.blue  = static_cast<std::uint8_t>(index * 3U);
+        ++index;
+    }
+
+    Rectangle const dimensions{10U, 10U};
+
+    PNG::Writer writer{filepath};
+    writer.init();
+    writer.write(dimensions, toSpan<BGRAPixel const>(imageData));
+    writer.deinit();
+
+    PNG::Reader sut{filepath};
+    EXPECT_TRUE(sut.init());
+
+    // room for 3 rows and a bit, so the last call only reads the single remaining row
+    std::array<BGRAPixel, 35U> rowData{};
+    auto                       row = 0U;
+    for (auto const expectedRows : {3U, 3U, 3U, 1U, 0U})
+    {
+        auto const rows = sut.readRows(toSpan<BGRAPixel>(rowData));
+        ASSERT_EQ(rows, expectedRows);
+        for (auto i = 0U; i < rows * dimensions.width; ++i)
+        {
+            ASSERT_EQ(rowData[i], imageData[row * dimensions.width + i]);
+        }
+        row += rows;
+    }
+    EXPECT_FALSE(sut.read(toSpan<BGRAPixel>(rowData)));
+    sut.deinit();
+}
+
+TEST_F(IOPNGReader, ReadingIntoTooSmallBufferFails)
+{
+    std::array<BGRAPixel, 100U> imageData{};
+
+    Rectangle const dimensions{10U, 10U};
+
+    PNG::Writer writer{filepath};
+    writer.init();
+    writer.write(dimensions, toSpan<BGRAPixel const>(imageData));
+    writer.deinit();
+
+    PNG::Reader sut{filepath};
+    EXPECT_TRUE(sut.init());
+    std::array<BGRAPixel, 99U> loadedData{};
+    EXPECT_FALSE(sut.read(toSpan<BGRAPixel>(loadedData)));
+    sut.deinit();
+}
+
 } // namespace Terrahertz::UnitTests
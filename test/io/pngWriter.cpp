@@ -2,11 +2,13 @@
 
 #include "THzCommon/utility/fstreamhelpers.hpp"
 #include "THzImage/common/image.hpp"
+#include "THzImage/io/pngReader.hpp"
 
 #include <array>
 #include <cstdio>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -48,7 +50,236 @@ TEST_F(IOPNGWriter, WritingCreatesFile)
     EXPECT_EQ(magic[3U], 'G');
 }
 
+TEST_F(IOPNGWriter, CompressionLevelIsLimited)
+{
+    PNG::Writer sut{filepath, PNG::CompressionOptions{12U}};
+    EXPECT_EQ(sut.compressionOptions().level, 9U);
+    sut.setCompressionOptions(PNG::CompressionOptions::fast());
+    EXPECT_EQ(sut.compressionOptions().level, 1U);
+    EXPECT_EQ(sut.compressionOptions().filter, PNG::Filter::sub);
+    EXPECT_EQ(sut.compressionOptions().strategy, PNG::Strategy::rle);
+}
+
+TEST_F(IOPNGWriter, CompressionOptionsKeepTheImageIntact)
+{
+    Rectangle const dimensions{0, 0, 16U, 12U};
+
+    std::array<BGRAPixel, 192U> imageData{};
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(i),
+                                 static_cast<std::uint8_t>(i / 16U),
+                                 static_cast<std::uint8_t>(i % 16U),
+                                 static_cast<std::uint8_t>(255U - (i % 3U))};
+    }
+
+    for (auto const filter :
+         {PNG::Filter::none, PNG::Filter::sub, PNG::Filter::up, PNG::Filter::paeth, PNG::Filter::adaptive})
+    {
+        for (auto const strategy :
+             {PNG::Strategy::automatic, PNG::Strategy::standard, PNG::Strategy::filtered, PNG::Strategy::rle})
+        {
+            PNG::Writer sut{filepath, PNG::CompressionOptions{1U, filter, strategy}};
+            EXPECT_TRUE(sut.init());
+            EXPECT_TRUE(sut.write(dimensions, toSpan<BGRAPixel const>(imageData)));
+            sut.deinit();
+
+            std::array<BGRAPixel, 192U> loadedData{};
+
+            PNG::Reader reader{filepath};
+            EXPECT_TRUE(reader.init());
+            EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+            reader.deinit();
+            EXPECT_EQ(loadedData, imageData);
+        }
+    }
+}
+
+TEST_F(IOPNGWriter, ParallelEncodingKeepsTheImageIntact)
+{
+    // large enough to be compressed in several bands
+    Rectangle const dimensions{0, 0, 512U, 384U};
+
+    std::vector<BGRAPixel> imageData(dimensions.area());
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        auto const x  = i % dimensions.width;
+        auto const y  = i / dimensions.width;
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(x),
+                                 static_cast<std::uint8_t>(y),
+                                 static_cast<std::uint8_t>((x * y) >> 4U),
+                                 static_cast<std::uint8_t>((x < 256U) ? 255U : (i * 7U))};
+    }
+
+    for (auto const filter :
+         {PNG::Filter::none, PNG::Filter::sub, PNG::Filter::up, PNG::Filter::paeth, PNG::Filter::adaptive})
+    {
+        for (auto const threads : {2U, 4U})
+        {
+            PNG::Writer sut{filepath, PNG::CompressionOptions{6U, filter}, threads};
+            EXPECT_TRUE(sut.init());
+            EXPECT_TRUE(sut.write(dimensions, toSpan<BGRAPixel const>(imageData)));
+            sut.deinit();
+
+            std::vector<BGRAPixel> loadedData(dimensions.area());
+
+            PNG::Reader reader{filepath};
+            EXPECT_TRUE(reader.init());
+            EXPECT_EQ(reader.dimensions(), dimensions);
+            EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+            reader.deinit();
+            EXPECT_EQ(loadedData, imageData);
+        }
+    }
+}
+
+TEST_F(IOPNGWriter, ParallelEncodingWithRowsNotDividingEvenly)
+{
+    // 17 rows for 16 targeted jobs yield 2 rows per job, so only 9 jobs are needed
+    Rectangle const dimensions{0, 0, 9U, 17U};
+
+    std::vector<BGRAPixel> imageData(dimensions.area());
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(i),
+                                 static_cast<std::uint8_t>(i * 3U),
+                                 static_cast<std::uint8_t>(i * 5U),
+                                 static_cast<std::uint8_t>(255U - i)};
+    }
+
+    PNG::Writer sut{filepath, PNG::CompressionOptions{6U, PNG::Filter::paeth}, 4U};
+    EXPECT_TRUE(sut.init());
+    EXPECT_TRUE(sut.write(dimensions, toSpan<BGRAPixel const>(imageData)));
+    sut.deinit();
+
+    std::vector<BGRAPixel> loadedData(dimensions.area());
+
+    PNG::Reader reader{filepath};
+    EXPECT_TRUE(reader.init());
+    EXPECT_EQ(reader.dimensions(), dimensions);
+    EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+    reader.deinit();
+    EXPECT_EQ(loadedData, imageData);
+}
+
+TEST_F(IOPNGWriter, ParallelEncodingOfSmallImage)
+{
+    Rectangle const dimensions{0, 0, 3U, 2U};
+
+    std::array<BGRAPixel, 6U> imageData{};
+    imageData[1U] = BGRAPixel{1U, 2U, 3U, 4U};
+    imageData[4U] = BGRAPixel{5U, 6U, 7U, 8U};
+
+    PNG::Writer sut{filepath, PNG::CompressionOptions::fast(), 8U};
+    EXPECT_TRUE(sut.init());
+    EXPECT_TRUE(sut.write(dimensions, toSpan<BGRAPixel const>(imageData)));
+    sut.deinit();
+
+    std::array<BGRAPixel, 6U> loadedData{};
+
+    PNG::Reader reader{filepath};
+    EXPECT_TRUE(reader.init());
+    EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+    reader.deinit();
+    EXPECT_EQ(loadedData, imageData);
+}
+
 // if data is written correctly will be tested along with the Reader
 // additional tests are omitted due to libpng being tested by its devs anyway
 
+TEST_F(IOPNGWriter, WritingRowByRow)
+{
+    Rectangle const dimensions{0, 0, 4U, 5U};
+
+    std::array<BGRAPixel, 20U> imageData{};
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(i), 0x10U, static_cast<std::uint8_t>(i * 3U), 0xF0U};
+    }
+
+    PNG::Writer sut{filepath};
+    auto const  data = toSpan<BGRAPixel const>(imageData);
+    EXPECT_FALSE(sut.writeRows(data.subspan(0U, 4U)));
+    EXPECT_TRUE(sut.begin(dimensions));
+    EXPECT_FALSE(sut.begin(dimensions));
+    EXPECT_FALSE(sut.writeRows(data.subspan(0U, 3U)));
+    EXPECT_TRUE(sut.writeRows(data.subspan(0U, 8U)));
+    EXPECT_TRUE(sut.writeRows(data.subspan(8U, 12U)));
+    EXPECT_FALSE(sut.writeRows(data.subspan(0U, 4U)));
+    EXPECT_TRUE(sut.end());
+    EXPECT_FALSE(sut.end());
+
+    std::array<BGRAPixel, 20U> loadedData{};
+
+    PNG::Reader reader{filepath};
+    EXPECT_TRUE(reader.init());
+    EXPECT_TRUE(reader.read(toSpan<BGRAPixel>(loadedData)));
+    reader.deinit();
+    EXPECT_EQ(loadedData, imageData);
+}
+
+TEST_F(IOPNGWriter, EndingAnIncompleteImageFails)
+{
+    std::array<BGRAPixel, 8U> imageData{};
+
+    PNG::Writer sut{filepath};
+    EXPECT_TRUE(sut.begin(Rectangle{4U, 4U}));
+    EXPECT_TRUE(sut.writeRows(toSpan<BGRAPixel const>(imageData)));
+    EXPECT_FALSE(sut.end());
+}
+
+TEST_F(IOPNGWriter, WritingIndexedImage)
+{
+    std::array<BGRAPixel, 3U> const palette{
+        BGRAPixel{0xFFU, 0U, 0U}, BGRAPixel{0U, 0x80U, 0U, 0x80U}, BGRAPixel{0U, 0U, 0U, 0U}};
+    IndexedImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{13U, 7U}));
+    ASSERT_TRUE(image.setPalette(palette));
+    for (auto i = 0U; i < image.dimensions().area(); ++i)
+    {
+        image[i] = static_cast<std::uint8_t>(i % palette.size());
+    }
+
+    PNG::Writer sut{filepath};
+    ASSERT_TRUE(sut.write(image));
+
+    // 3 colors are stored with 2 bits per pixel using the palette color type
+    std::ifstream                 stream{filepath, std::ios::binary};
+    std::array<std::uint8_t, 26U> header{};
+    ASSERT_EQ(readFromStream(stream, header), header.size());
+    EXPECT_EQ(header[24U], 2U);
+    EXPECT_EQ(header[25U], 3U);
+    stream.close();
+
+    BGRAImage expected{};
+    ASSERT_TRUE(image.expandInto(expected));
+    BGRAImage   read{};
+    PNG::Reader reader{filepath};
+    ASSERT_TRUE(read.readFrom(reader));
+    EXPECT_EQ(read, expected);
+}
+
+TEST_F(IOPNGWriter, WritingEmptyIndexedImageFails)
+{
+    IndexedImage image{};
+    PNG::Writer  sut{filepath};
+    EXPECT_FALSE(sut.write(image));
+    ASSERT_TRUE(image.setDimensions(Rectangle{2U, 2U}));
+    EXPECT_FALSE(sut.write(image));
+}
+
+TEST_F(IOPNGWriter, IndicesOutsideOfThePaletteFail)
+{
+    std::array<BGRAPixel, 3U> const palette{BGRAPixel{1U, 2U, 3U}, BGRAPixel{4U, 5U, 6U}, BGRAPixel{7U, 8U, 9U}};
+    IndexedImage                    image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{2U, 2U}));
+    ASSERT_TRUE(image.setPalette(palette));
+    image[3U] = 3U;
+
+    PNG::Writer sut{filepath};
+    EXPECT_FALSE(sut.write(image));
+    image[3U] = 2U;
+    EXPECT_TRUE(sut.write(image));
+}
+
 } // namespace Terrahertz::UnitTests
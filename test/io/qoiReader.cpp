@@ -1,11 +1,15 @@
 #include "THzImage/io/qoiReader.hpp"
 
 #include "THzCommon/utility/spanhelpers.hpp"
+#include "THzImage/common/image.hpp"
 #include "THzImage/io/qoiWriter.hpp"
 
 #include <array>
 #include <cstdint>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -222,6 +226,78 @@ TEST_F(IOQOIReader, ImageBufferExhausted)
     EXPECT_EQ(imageArray[imageArray.size() - 1U], expectedColor);
 }
 
+TEST_F(IOQOIReader, DecompressMatchesStreamingDecompression)
+{
+    std::array<BGRAPixel, 64U> original{};
+    for (auto i = 0U; i < original.size(); ++i)
+    {
+        // mix of runs, small and large differences and alpha changes
+        auto const value = static_cast<std::uint8_t>((i / 4U) * ((i % 3U) == 0U ? 1U : 37U));
+        original[i]      = BGRAPixel{value,
+                                static_cast<std::uint8_t>(value + 3U),
+                                value,
+                                static_cast<std::uint8_t>((i > 48U) ? value : 0xFFU)};
+    }
+    std::vector<std::uint8_t> data{};
+    QOI::Internal::Compressor compressor{};
+    for (auto const &pixel : original)
+    {
+        auto const bytes = compressor.nextPixel(pixel);
+        data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+    auto const bytes = compressor.flush();
+    data.insert(data.end(), bytes.begin(), bytes.end());
+
+    EXPECT_EQ(decompressor.insertDataChunk(data), data.size());
+    std::array<BGRAPixel, 64U> result{};
+    EXPECT_EQ(QOI::Internal::Decompressor::decompress(data, result), result.size());
+    EXPECT_EQ(result, original);
+    EXPECT_EQ(imageArray, original);
+}
+
+TEST_F(IOQOIReader, DecompressIndexesStartPixelAfterRun)
+{
+    BGRAPixel const                    otherColor{0x34U, 0x23U, 0x12U, 0x45U};
+    std::array<std::uint8_t, 8U> const data{OpRun | 2U,
+                                            OpRGBA,
+                                            otherColor.red,
+                                            otherColor.green,
+                                            otherColor.blue,
+                                            otherColor.alpha,
+                                            static_cast<std::uint8_t>(OpIndex | hash(startColor)),
+                                            OpRun};
+    std::array<BGRAPixel, 6U> const    expected{startColor, startColor, startColor, otherColor, startColor, startColor};
+
+    EXPECT_EQ(decompressor.insertDataChunk(data), data.size());
+    std::array<BGRAPixel, 6U> result{};
+    EXPECT_EQ(QOI::Internal::Decompressor::decompress(data, result), result.size());
+    EXPECT_EQ(result, expected);
+    for (auto i = 0U; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(imageArray[i], expected[i]);
+    }
+}
+
+TEST_F(IOQOIReader, DecompressStopsAtEndOfBuffer)
+{
+    std::array<std::uint8_t, 10U> data{OpRGBA, 0x12U, 0x23U, 0x34U, 0x45U, OpRun | 61U, 0U, 0U, 0U, 1U};
+    std::array<BGRAPixel, 3U>     result{};
+    EXPECT_EQ(QOI::Internal::Decompressor::decompress(data, result), 3U);
+    BGRAPixel const expectedColor{0x34U, 0x23U, 0x12U, 0x45U};
+    for (auto const &pixel : result)
+    {
+        EXPECT_EQ(pixel, expectedColor);
+    }
+}
+
+TEST_F(IOQOIReader, DecompressStopsAtIncompleteOp)
+{
+    std::array<std::uint8_t, 7U> data{OpRGB, 0x12U, 0x23U, 0x34U, OpRGBA, 0x12U, 0x23U};
+    std::array<BGRAPixel, 3U>    result{};
+    EXPECT_EQ(QOI::Internal::Decompressor::decompress(data, result), 1U);
+    EXPECT_EQ(result[0U], (BGRAPixel{0x34U, 0x23U, 0x12U}));
+}
+
 TEST_F(IOQOIReader, ConstructionCorrect)
 {
     QOI::Reader sut{filepath};
@@ -305,4 +381,78 @@ TEST_F(IOQOIReader, ReadingData)
     EXPECT_FALSE(sut.imagePresent());
 }
 
+TEST_F(IOQOIReader, ReadingIncompleteDataFails)
+{
+    prepareTestFile(gsl::span<std::uint8_t const>{testFilecontent}.subspan(0U, 28U));
+
+    QOI::Reader sut{filepath};
+    ASSERT_TRUE(sut.init());
+    std::array<BGRAPixel, 4U> arr{};
+    EXPECT_FALSE(sut.read(toSpan<BGRAPixel>(arr)));
+}
+
+TEST_F(IOQOIReader, TrailingDataIsIgnored)
+{
+    std::vector<std::uint8_t> content{testFilecontent.begin(), testFilecontent.end()};
+    content.insert(content.end(), {0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U});
+    prepareTestFile(content);
+
+    QOI::Reader sut{filepath};
+    ASSERT_TRUE(sut.init());
+    std::array<BGRAPixel, 4U> arr{};
+    EXPECT_TRUE(sut.read(toSpan<BGRAPixel>(arr)));
+    EXPECT_EQ(arr[3U], BGRAPixel{});
+}
+
+TEST_F(IOQOIReader, ChunkedFileReadInParallelAndSequentially)
+{
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{37U, 29U}));
+    for (auto i = 0U; i < image.dimensions().area(); ++i)
+    {
+        auto const value = static_cast<std::uint8_t>((i / 5U) * 7U);
+        image[i]         = BGRAPixel{value,
+                             static_cast<std::uint8_t>(i),
+                             value,
+                             static_cast<std::uint8_t>((i % 97U == 0U) ? value : 0xFFU)};
+    }
+    QOI::Writer writer{filepath, 3U};
+    ASSERT_TRUE(image.writeTo(&writer));
+
+    for (auto const threads : {1U, 4U})
+    {
+        QOI::Reader reader{filepath, threads};
+        BGRAImage   result{};
+        ASSERT_TRUE(result.readFrom(reader));
+        EXPECT_EQ(result, image);
+    }
+}
+
+TEST_F(IOQOIReader, ChunkedFileWithCorruptedIndexFallsBack)
+{
+    BGRAImage image{};
+    ASSERT_TRUE(image.setDimensions(Rectangle{8U, 8U}));
+    for (auto i = 0U; i < image.dimensions().area(); ++i)
+    {
+        image[i] = BGRAPixel{static_cast<std::uint8_t>(i * 3U), 0U, static_cast<std::uint8_t>(i)};
+    }
+    QOI::Writer writer{filepath, 2U};
+    ASSERT_TRUE(image.writeTo(&writer));
+
+    // corrupt the first offset of the index
+    std::vector<std::uint8_t> content{};
+    {
+        std::ifstream stream{filepath, std::ios::binary};
+        content.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+    }
+    auto const chunks = content[content.size() - 9U];
+    content[content.size() - 12U - (chunks * 4U)] = 0xFFU;
+    prepareTestFile(content);
+
+    QOI::Reader reader{filepath, 4U};
+    BGRAImage   result{};
+    ASSERT_TRUE(result.readFrom(reader));
+    EXPECT_EQ(result, image);
+}
+
 } // namespace Terrahertz::UnitTests
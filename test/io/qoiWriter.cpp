@@ -4,7 +4,9 @@
 #include "THzCommon/utility/spanhelpers.hpp"
 
 #include <cstdint>
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace Terrahertz::UnitTests {
 
@@ -330,6 +332,55 @@ TEST_F(IOQOIWriter, FlushReturnsOpRunCodeIfPresent)
     EXPECT_EQ(code[0U], (OpRun | 7U));
 }
 
+TEST_F(IOQOIWriter, CompressMatchesPixelWiseCompression)
+{
+    std::vector<BGRAPixel> pixels(300U);
+    for (auto i = 0U; i < pixels.size(); ++i)
+    {
+        // runs of different lengths, including one longer than 62 pixels, mixed with varying colors
+        auto const value = static_cast<std::uint8_t>((i < 140U) ? (i / 7U) : (i * 13U));
+        pixels[i]        = BGRAPixel{value,
+                              value,
+                              static_cast<std::uint8_t>(value + 1U),
+                              static_cast<std::uint8_t>((i > 250U) ? value : 0xFFU)};
+    }
+
+    std::vector<std::uint8_t> expected{};
+    for (auto const &pixel : pixels)
+    {
+        auto const code = compressor.nextPixel(pixel);
+        expected.insert(expected.end(), code.begin(), code.end());
+    }
+    auto const expectedFlush = compressor.flush();
+    expected.insert(expected.end(), expectedFlush.begin(), expectedFlush.end());
+
+    QOI::Internal::Compressor sut{};
+    std::vector<std::uint8_t> result(QOI::Internal::Compressor::maxCompressedSize(pixels.size()));
+    result.resize(sut.compress(pixels, result));
+    auto const flush = sut.flush();
+    result.insert(result.end(), flush.begin(), flush.end());
+    EXPECT_EQ(result, expected);
+}
+
+TEST_F(IOQOIWriter, CompressSplitsLongRuns)
+{
+    std::vector<BGRAPixel>    pixels(130U, startColor);
+    std::vector<std::uint8_t> result(QOI::Internal::Compressor::maxCompressedSize(pixels.size()));
+    ASSERT_EQ(compressor.compress(pixels, result), 2U);
+    EXPECT_EQ(result[0U], (OpRun | 61U));
+    EXPECT_EQ(result[1U], (OpRun | 61U));
+    auto const code = compressor.flush();
+    ASSERT_EQ(code.size(), 1U);
+    EXPECT_EQ(code[0U], (OpRun | 5U));
+}
+
+TEST_F(IOQOIWriter, CompressFailsIfOutputIsTooSmall)
+{
+    std::array<BGRAPixel, 4U>     pixels{};
+    std::array<std::uint8_t, 20U> result{};
+    EXPECT_EQ(compressor.compress(pixels, result), 0U);
+}
+
 TEST_F(IOQOIWriter, DimensionsDoNotFitBufferSize)
 {
     QOI::Writer sut{filepath};
@@ -362,4 +413,56 @@ TEST_F(IOQOIWriter, Writing)
     }
 }
 
+TEST_F(IOQOIWriter, WritingEmptyImageWithThreadsMatchesPlainFile)
+{
+    Rectangle const dimensions{0, 0, 5U, 0U};
+
+    QOI::Writer writer{"testWritePlain.qoi"};
+    EXPECT_TRUE(writer.write(dimensions, {}));
+
+    QOI::Writer sut{filepath, 2U};
+    EXPECT_TRUE(sut.write(dimensions, {}));
+
+    std::ifstream                 expectedFile{"testWritePlain.qoi", std::ios::binary};
+    std::ifstream                 file{filepath, std::ios::binary};
+    std::array<std::uint8_t, 64U> expected{};
+    std::array<std::uint8_t, 64U> buffer{};
+    auto const                    size = readFromStream(expectedFile, expected);
+    EXPECT_GT(size, 0U);
+    EXPECT_EQ(readFromStream(file, buffer), size);
+    EXPECT_EQ(buffer, expected);
+    std::remove("testWritePlain.qoi");
+}
+
+TEST_F(IOQOIWriter, WritingRowByRowMatchesWriting)
+{
+    Rectangle const dimensions{0, 0, 10U, 10U};
+
+    std::vector<BGRAPixel> imageData(100U);
+    for (auto i = 0U; i < imageData.size(); ++i)
+    {
+        imageData[i] = BGRAPixel{static_cast<std::uint8_t>(i / 7U), 0x20U, static_cast<std::uint8_t>(i / 13U), 0xFFU};
+    }
+    QOI::Writer writer{"testWriteWhole.qoi"};
+    EXPECT_TRUE(writer.write(dimensions, imageData));
+
+    QOI::Writer sut{filepath};
+    EXPECT_TRUE(sut.begin(dimensions));
+    auto const data = gsl::span<BGRAPixel const>{imageData};
+    for (auto row = 0U; row < 10U; row += 5U)
+    {
+        EXPECT_TRUE(sut.writeRows(data.subspan(row * 10U, 50U)));
+    }
+    EXPECT_TRUE(sut.end());
+
+    std::ifstream                  expectedFile{"testWriteWhole.qoi", std::ios::binary};
+    std::ifstream                  file{filepath, std::ios::binary};
+    std::array<std::uint8_t, 512U> expected{};
+    std::array<std::uint8_t, 512U> buffer{};
+    auto const                     size = readFromStream(expectedFile, expected);
+    EXPECT_EQ(readFromStream(file, buffer), size);
+    EXPECT_EQ(buffer, expected);
+    std::remove("testWriteWhole.qoi");
+}
+
 } // namespace Terrahertz::UnitTests
@@ -62,6 +62,18 @@ TEST_F(ProcessingEasyWriter, NonBGRAImageIsWrittenCorrectly)
     std::filesystem::remove_all("nodeWriterNonBGRA");
 }
 
+TEST_F(ProcessingEasyWriter, FastCompressionIsUsable)
+{
+    std::filesystem::create_directories("nodeWriterFast");
+
+    SutClass sut{"nodeWriterFast/image_?.png", PNG::CompressionOptions::fast()};
+    EXPECT_TRUE(testNode.next());
+    EXPECT_TRUE(sut.write(testNode[0U]));
+    EXPECT_EQ(getDimensionsOf("nodeWriterFast/image_000000.png"), baseDimensions);
+
+    std::filesystem::remove_all("nodeWriterFast");
+}
+
 TEST_F(ProcessingEasyWriter, AppendWorksAsExpected) {}
 
 } // namespace Terrahertz::UnitTests
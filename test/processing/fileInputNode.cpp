@@ -9,6 +9,7 @@
 #include <filesystem>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <map>
 #include <string>
 
 namespace Terrahertz::UnitTests {
@@ -87,6 +88,7 @@ TEST_F(ProcessingFileInputNode, IndexOutOfBoundsReturnsEmpty)
     std::filesystem::path const expectedPath{};
     EXPECT_EQ(sut[1U].dimensions(), expectedDimensions);
     EXPECT_EQ(sut.pathOf(1U), expectedPath);
+    EXPECT_FALSE(sut.share(1U));
 }
 
 TEST_F(ProcessingFileInputNode, Automatic)
@@ -136,6 +138,33 @@ TEST_F(ProcessingFileInputNode, Automatic)
     }
 }
 
+TEST_F(ProcessingFileInputNode, AutomaticWithWorkers)
+{
+    SutClass sut{10U, "fileNodeTest", SutClass::Mode::automatic, 2U};
+    for (auto i = 1U; i <= 5U; ++i)
+    {
+        EXPECT_TRUE(sut.next());
+        EXPECT_EQ(sut.count(), i);
+    }
+    EXPECT_FALSE(sut.next());
+    EXPECT_EQ(sut.count(), 5U);
+
+    std::map<std::uint8_t, std::filesystem::path> const expected{{0x0FU, "fileNodeTest/subDir/containsImage"},
+                                                                 {0x1FU, "fileNodeTest/subDir/testQoi.qoi"},
+                                                                 {0x2FU, "fileNodeTest/actuallyQoi.png"},
+                                                                 {0x3FU, "fileNodeTest/testBmp.bmp"},
+                                                                 {0x4FU, "fileNodeTest/testPng.png"}};
+    std::map<std::uint8_t, std::filesystem::path> loaded{};
+    for (auto i = 0U; i < sut.slots(); ++i)
+    {
+        if (sut[i].dimensions().area() != 0U)
+        {
+            loaded.emplace(sut[i][0U].blue, sut.pathOf(i));
+        }
+    }
+    EXPECT_EQ(loaded, expected);
+}
+
 TEST_F(ProcessingFileInputNode, ExtensionBased)
 {
     SutClass sut{10U, "fileNodeTest", SutClass::Mode::extensionBased};
@@ -54,6 +54,7 @@ TEST_F(ProcessingReaderlessNodeBase, ConstructionAsExpected)
     EXPECT_EQ(sut.count(), 0U);
     EXPECT_EQ(sut[0U].dimensions(), defaultDimensions);
     EXPECT_EQ(sut[4U].dimensions(), defaultDimensions);
+    EXPECT_FALSE(sut.share(4U));
 }
 
 TEST_F(ProcessingReaderlessNodeBase, CallingNextAdvancesCount)